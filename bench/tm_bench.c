@@ -0,0 +1,331 @@
+// TMGUI benchmark suite. Headless: no window, cells are rendered through the soft (or null) backend.
+//
+// Build from the repo root (raylib on the include/lib path):
+//   cc -std=c99 -O2 -Iinclude -DTMGUI_NO_DEMO bench/tm_bench.c lib/tmgui.c -lraylib -lm -o tm_bench
+// and run it from the repo root too, it reads fonts/ and glyphs/ (or add -DTMGUI_EMBED_ASSETS, see tools/tm_bake.c).
+//
+// Usage: tm_bench [--frames N] [--backend soft|null] [--filter name] [--replay session.tmrc] [--inputs session.tmrc]
+// Prints one JSON object per benchmark on stdout, so runs can be diffed / tracked for regressions.
+// --replay renders a tm_record_start recording as fast as possible instead of the built in workloads.
+// --inputs drives the workloads with a recording's input track (tm_input_script) instead of their own.
+// 'layout' is tm_canvas_begin + the element calls, 'draw' is tm_canvas_end (diff + backend).
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 199309L // clock_gettime under -std=c99
+#endif
+#include "tmgui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32 // declared by hand, windows.h clashes with raylib's names
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *freq);
+#endif
+
+typedef struct {
+    const char *name;
+    int grid_w, grid_h;
+    int (*frame)(int frame); // builds one frame of UI, returns the number of elements it emitted
+    void (*input)(int frame, tm_input *in); // scripted input for the frame, NULL = none
+    void (*setup)(void); // before the first frame, NULL = none. Animations are cleared after the workload
+} bench;
+
+static double now_ns(void) { // monotonic
+#ifdef _WIN32
+    static long long freq = 0;
+    long long count;
+    if (freq == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&count);
+    return (double)count * 1e9 / (double)freq;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+#endif
+}
+
+// --- Workloads ------------------------------------------------------------------------------------------
+
+static int bench_labels_vbox(int frame) { // 10 columns of 100 labels plus 100 texts, static content
+    (void)frame;
+    int n = 0;
+    tm_set_spacing(0);
+    for (int col = 0; col < 10; col++) {
+        tm_vbox(RECT(col * 20, 0, 20, 0));
+        for (int row = 0; row < 50; row++, n += 2) {
+            tm_label("INVENTORY ITEM", AUTO);
+            tm_text(">you ate the bug", AUTO);
+        }
+    }
+    return n;
+}
+
+static int bench_text_hbox(int frame) { // 100 rows of short texts, one word changes per frame
+    char buf[16];
+    int n = 0;
+    tm_set_spacing(1);
+    for (int row = 0; row < 100; row++) {
+        tm_hbox(RECT(0, row, 0, 1));
+        for (int i = 0; i < 20; i++, n++) {
+            if (i == frame % 20) { snprintf(buf, sizeof(buf), "%05d", frame); tm_text(buf, AUTO); }
+            else tm_text("WORD", AUTO);
+        }
+    }
+    return n;
+}
+
+static int bench_panel_grid(int frame) { // full screen of 10x5 panels, static
+    (void)frame;
+    int n = 0;
+    for (int y = 0; y + 5 <= 100; y += 5)
+        for (int x = 0; x + 10 <= 200; x += 10, n++)
+            tm_panel(RECT(x, y, 10, 5));
+    return n;
+}
+
+static int bench_full_dynamic(int frame) { // every cell changes every frame, worst case for the diff
+    static char line[201];
+    int n = 0;
+    for (int y = 0; y < 100; y++, n++) {
+        for (int x = 0; x < 200; x++) line[x] = 'A' + (x + y + frame) % 26;
+        line[200] = '\0';
+        tm_text(line, POS(0, y));
+    }
+    return n;
+}
+
+static int bench_hud(int frame) { // the demo HUD layout, one log line changes per frame
+    char buf[32];
+    tm_set_spacing(1);
+    ALIGN(LEFT, TOP);
+    tm_panel(RECT(0, 0, 14, 45));
+    tm_panel(RECT(12, 0, 13, 45));
+    tm_panel_titled("TITLE", RECT(25, 32, 56, 16), 2);
+    ALIGN(LEFT, CENTER);
+    tm_vbox(RECT(26, 33, 54, 16));
+    tm_label("", AUTO);
+    tm_label_panel("ACTIONS", SIZE(9, 3), -1);
+    for (int i = 0; i < 4; i++) {
+        snprintf(buf, sizeof(buf), ">you ate bug #%d", (i == 3) ? frame : i);
+        tm_text(buf, AUTO);
+    }
+    tm_vbox(RECT(1, 1, 11, 45));
+    ALIGN(CENTER, CENTER);
+    tm_label_panel("ABILITY", SIZE(-1, 3), 0);
+    tm_label_panel("  USE  ", AUTO, 0);
+    tm_label("BENT STRAW", SIZE(11, 3));
+    tm_label("DOG FUR", SIZE(11, 3));
+    return 13;
+}
+
+static int bench_buttons(int frame) { // 10x20 grid of buttons, hovered / pressed / clicked as the mouse sweeps
+    (void)frame;
+    static int clicks = 0;
+    char buf[16];
+    for (int y = 0; y < 20; y++) {
+        for (int x = 0; x < 10; x++) {
+            snprintf(buf, sizeof(buf), "BTN %d", y * 10 + x);
+            if (tm_button(buf, RECT(x * 20, y * 5, 18, 4))) clicks++;
+        }
+    }
+    return 200;
+}
+
+static void input_buttons(int frame, tm_input *in) { // one button further every 4 frames, clicking each one
+    int b = (frame / 4) % 200;
+    in->mouse = (Vector2){ (b % 10) * 20 + 9.5f, (b / 10) * 5 + 2.5f };
+    in->buttons = (frame % 4 == 1 || frame % 4 == 2) ? 1 << MOUSE_BUTTON_LEFT : 0;
+}
+
+static void list_row(int row, grect area, void *user) {
+    (void)user;
+    char buf[32];
+    snprintf(buf, sizeof(buf), "ITEM %06d", row);
+    tm_text(buf, area);
+}
+
+static int bench_list_scroll(int frame) { // 4 lists of 100k rows, scrolled by wheel and keys, rows clicked
+    (void)frame;
+    static tm_list_state lists[4] = { { 0, -1 }, { 0, -1 }, { 0, -1 }, { 0, -1 } };
+    for (int i = 0; i < 4; i++) {
+        tm_push_id_int(i);
+        tm_list(&lists[i], 100000, 1, list_row, NULL, RECT(i * 50, 0, 48, 40));
+        tm_pop_id();
+    }
+    return 4 * 40;
+}
+
+static void input_list_scroll(int frame, tm_input *in) { // over each list in turn: wheel, key repeat, a click
+    in->mouse = (Vector2){ ((frame / 60) % 4) * 50 + 10.5f, (frame * 7) % 40 + 0.5f };
+    in->wheel = (frame % 4 == 0) ? -1.0f : 0.0f;
+    in->buttons = (frame % 10 == 5) ? 1 << MOUSE_BUTTON_LEFT : 0;
+    in->key_count = 1;
+    in->keys[0] = KEY_DOWN;
+    in->key_repeat = (frame % 8) ? 1 : 0; // held down
+}
+
+static const atlaspos water[4] = { { 1, 0 }, { 2, 0 }, { 3, 0 }, { 2, 0 } };
+static const atlaspos torch[2] = { { 4, 0 }, { 5, 0 } };
+
+static void setup_animations(void) {
+    tm_animate_tile((tm_atlas){ 0 }, water[0], water, 4, 0.25f);
+    tm_animate_tile((tm_atlas){ 0 }, torch[0], torch, 2, 0.1f);
+}
+
+static int bench_animated_tiles(int frame) { // static screen with 2000 animated water / torch tiles
+    (void)frame;
+    bench_labels_vbox(0);
+    for (int i = 0; i < 2000; i++) {
+        atlaspos tile = (i % 10) ? water[0] : torch[0];
+        tm_draw_glyph(RECT((i * 37) % 200, (i * 13) % 100, 1, 1), tile, BLUE, BLACK);
+    }
+    return 1000 + 2000;
+}
+
+static void input_clock(int frame, tm_input *in) { // just the 60 Hz frame time that drives the animations
+    (void)frame;
+    (void)in;
+}
+
+static const bench benches[] = {
+    { "labels_vbox",  200, 100, bench_labels_vbox, NULL, NULL },
+    { "text_hbox",    200, 100, bench_text_hbox, NULL, NULL },
+    { "panel_grid",   200, 100, bench_panel_grid, NULL, NULL },
+    { "full_dynamic", 200, 100, bench_full_dynamic, NULL, NULL },
+    { "hud_80x47",    80,  47,  bench_hud, NULL, NULL },
+    { "buttons_input", 200, 100, bench_buttons, input_buttons, NULL },
+    { "list_input",   200, 100, bench_list_scroll, input_list_scroll, NULL },
+    { "animated_tiles", 200, 100, bench_animated_tiles, input_clock, setup_animations },
+};
+
+// --- Runner ---------------------------------------------------------------------------------------------
+
+static tm_input *script = NULL; // --inputs, replaces the workloads' own input
+static int script_frames = 0;
+
+static void run(const bench *b, int frames, const tm_backend *backend) {
+    tm_set_backend(backend);
+    tm_canvas canvas = tm_canvas_init(b->grid_w, b->grid_h, false);
+    unsigned char *pixels = malloc(tm_soft_buffer_size(&canvas));
+    tm_soft_set_target(&canvas, pixels);
+
+    double layout_ns = 0, draw_ns = 0;
+    long long elements = 0;
+    int warmup = frames / 10 + 1;
+
+    if (b->setup) b->setup();
+    if (script) tm_input_script(script, script_frames);
+    for (int f = -warmup; f < frames; f++) {
+        if (script && tm_input_script_left() == 0) tm_input_script(script, script_frames); // loop it
+        if (!script && b->input) {
+            tm_input in = { 0 };
+            in.frame_time = 1.0f / 60.0f;
+            b->input(f < 0 ? 0 : f, &in);
+            tm_input_inject(&in);
+        }
+        double t0 = now_ns();
+        tm_canvas_begin(&canvas);
+        int n = b->frame(f < 0 ? 0 : f);
+        double t1 = now_ns();
+        tm_canvas_end(&canvas);
+        double t2 = now_ns();
+        if (f < 0) continue;
+        layout_ns += t1 - t0;
+        draw_ns += t2 - t1;
+        elements += n;
+    }
+
+    double cells = (double)b->grid_w * b->grid_h * frames;
+    printf("{\"bench\":\"%s\",\"backend\":\"%s\",\"grid\":\"%dx%d\",\"frames\":%d,\"elements_per_frame\":%lld,"
+           "\"layout_ns_per_frame\":%.1f,\"layout_ns_per_element\":%.2f,\"layout_ns_per_cell\":%.3f,"
+           "\"draw_ns_per_frame\":%.1f,\"draw_ns_per_element\":%.2f,\"draw_ns_per_cell\":%.3f}\n",
+           b->name, backend->name, b->grid_w, b->grid_h, frames, elements / frames,
+           layout_ns / frames, layout_ns / elements, layout_ns / cells,
+           draw_ns / frames, draw_ns / elements, draw_ns / cells);
+    fflush(stdout);
+
+    tm_input_script(NULL, 0);
+    tm_clear_animations();
+    tm_canvas_unload(&canvas);
+    free(pixels);
+}
+
+// A recorded session: only the diff + backend work, 'layout' is decoding the frame
+static int run_replay(const char *path, const tm_backend *backend) {
+    tm_set_backend(backend);
+    tm_canvas canvas;
+    if (!tm_replay_open(path, &canvas)) { fprintf(stderr, "tm_bench: could not replay %s\n", path); return 1; }
+    unsigned char *pixels = malloc(tm_soft_buffer_size(&canvas));
+    tm_soft_set_target(&canvas, pixels);
+
+    double draw_ns = 0;
+    long long cells_drawn = 0;
+    int frames = 0;
+    for (;;) {
+        double t0 = now_ns();
+        bool more = tm_replay_frame(&canvas, NULL);
+        draw_ns += now_ns() - t0;
+        if (!more) break;
+        cells_drawn += tm_get_stats()->cells_drawn;
+        frames++;
+    }
+    if (frames == 0) frames = 1;
+
+    printf("{\"bench\":\"replay\",\"file\":\"%s\",\"backend\":\"%s\",\"grid\":\"%dx%d\",\"frames\":%d,"
+           "\"cells_drawn_per_frame\":%.1f,\"draw_ns_per_frame\":%.1f}\n",
+           path, backend->name, canvas.grid_w, canvas.grid_h, frames, (double)cells_drawn / frames, draw_ns / frames);
+
+    tm_replay_close();
+    tm_canvas_unload(&canvas);
+    free(pixels);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int frames = 500;
+    const tm_backend *backend = &TM_BACKEND_SOFT;
+    const char *filter = NULL;
+    const char *replay = NULL;
+    const char *inputs = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--frames") && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--backend") && i + 1 < argc) {
+            i++;
+            backend = !strcmp(argv[i], "null") ? &TM_BACKEND_NULL : &TM_BACKEND_SOFT;
+        }
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!strcmp(argv[i], "--replay") && i + 1 < argc) replay = argv[++i];
+        else if (!strcmp(argv[i], "--inputs") && i + 1 < argc) inputs = argv[++i];
+        else { fprintf(stderr, "usage: %s [--frames N] [--backend soft|null] [--filter name] [--replay file] [--inputs file]\n", argv[0]); return 1; }
+    }
+    if (frames < 1) frames = 1;
+
+    SetTraceLogLevel(LOG_WARNING);
+    if (!tmgui_init(8, 8)) { // blank cells would time an empty blit, not the workloads
+        fprintf(stderr, "tm_bench: built-in assets missing, run from the repo root or build with -DTMGUI_EMBED_ASSETS\n");
+        tmgui_shutdown();
+        return 1;
+    }
+    if (replay) {
+        int status = run_replay(replay, backend);
+        tmgui_shutdown();
+        return status;
+    }
+    if (inputs) {
+        script = malloc(sizeof(tm_input) * 100000);
+        script_frames = tm_replay_inputs(inputs, script, 100000);
+        if (script_frames == 0) { fprintf(stderr, "tm_bench: no input frames in %s\n", inputs); return 1; }
+    }
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        if (filter && !strstr(benches[i].name, filter)) continue;
+        run(&benches[i], frames, backend);
+    }
+
+    free(script);
+    tmgui_shutdown();
+    return 0;
+}
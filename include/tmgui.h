@@ -7,6 +7,85 @@
 //4 components - x position, y position, w width, h height
 typedef struct { int x, y, w, h; } grect;
 
+// --- Retained Cell Grid ---
+// Cell storage is static, these bound it. Override before including tmgui.h / on the command line.
+#ifndef TM_MAX_CELLS
+#define TM_MAX_CELLS (320 * 180) // max grid_w * grid_h of a single canvas
+#endif
+#ifndef TM_MAX_CANVASES
+#define TM_MAX_CANVASES 8 // cell grids, shared by canvases and their extra layers
+#endif
+#ifndef TM_MAX_CANVAS_LAYERS
+#define TM_MAX_CANVAS_LAYERS 4 // named layers on top of a canvas' base layer
+#endif
+#ifndef TM_MAX_ATLASES
+#define TM_MAX_ATLASES 8 // glyph sheets registered with tm_load_atlas, the default one included
+#endif
+#ifndef TM_MAX_FONTS
+#define TM_MAX_FONTS 8
+#endif
+#ifndef TM_MAX_COMMANDS
+#define TM_MAX_COMMANDS 8192 // deferred draw list capacity (tm_set_deferred)
+#endif
+#ifndef TM_MAX_COMMAND_TEXT
+#define TM_MAX_COMMAND_TEXT (64 * 1024) // bytes of text the deferred draw list can hold per frame
+#endif
+#ifndef TM_MAX_LAYERS
+#define TM_MAX_LAYERS 8
+#endif
+#ifndef TM_MAX_WIDGETS
+#define TM_MAX_WIDGETS 1024 // retained widget state entries, power of two
+#endif
+#ifndef TM_ID_STACK_DEPTH
+#define TM_ID_STACK_DEPTH 16
+#endif
+#ifndef TM_MAX_NESTING
+#define TM_MAX_NESTING 16 // depth of the tm_vbox_begin / tm_hbox_begin container stack
+#endif
+#ifndef TM_MAX_ASYNC_JOBS
+#define TM_MAX_ASYNC_JOBS 16 // font / glyph sheet loads in flight on the asset worker
+#endif
+#ifndef TM_MAX_ANIMS
+#define TM_MAX_ANIMS 64 // animated tiles, see tm_animate_tile
+#endif
+#ifndef TM_MAX_ANIM_FRAMES
+#define TM_MAX_ANIM_FRAMES 16
+#endif
+#ifndef TM_MAX_ANIM_CELLS
+#define TM_MAX_ANIM_CELLS 8192 // cells showing an animated tile, per canvas / layer
+#endif
+#ifndef TM_ASSET_DIR
+#define TM_ASSET_DIR "" // where fonts/ and glyphs/ are read from when not embedded, "" = the working directory
+#endif
+#ifndef TM_SOFT_TEXELS
+#define TM_SOFT_TEXELS (1 << 20) // CPU glyph page storage for the software rasterizer, in pixels
+#endif
+#ifndef TM_SOFT_1BPP
+#define TM_SOFT_1BPP 1 // two color pages (glyph sheets, pixel fonts) kept 1 bit per pixel for tm_soft_*, 0 = RGBA
+#endif
+#ifndef TM_INPUT_KEYS
+#define TM_INPUT_KEYS 8 // key presses kept per frame in a tm_input, at most 32
+#endif
+#ifndef TM_RASTER_THREADS
+#define TM_RASTER_THREADS 3 // tm_soft_render workers besides the calling thread, 0 = single threaded
+#endif
+#ifndef TM_RASTER_BAND
+#define TM_RASTER_BAND 4 // cell rows per tm_soft_render work item
+#endif
+
+// Which page a cell's glyph comes from: TM_PAGE_ATLAS + atlas slot, TM_PAGE_FONT + font slot.
+// All pages are packed into one shared texture, so the page is a range in it, not a texture bind.
+enum { TM_PAGE_NONE = 0, TM_PAGE_ATLAS = 1, TM_PAGE_FONT = 1 + TM_MAX_ATLASES };
+
+// One grid cell as the draw primitives leave it, and as the backends get it. Compared bytewise between frames,
+// keep it padding free. TM_PALETTE_CELLS grids store a 4 byte palette form and expand it, see Palette.
+typedef struct {
+	unsigned short glyph; // cell on its page, y * columns + x (fonts are baked into grid pages too)
+	unsigned char page;   // TM_PAGE_NONE = background only
+	unsigned char flags;
+	Color fg, bg;
+} tm_cell;
+
 // --- Offscreen Canvas ---
 typedef struct {
 	RenderTexture2D target;
@@ -14,6 +93,9 @@ typedef struct {
 	int scale;
 	int offset_x, offset_y;
 	bool transparent;
+	int slot; // index into the static cell grids, -1 if none was free
+	int layer_count;                       // named layers over the base one, see tm_canvas_add_layer
+	int layer_slots[TM_MAX_CANVAS_LAYERS]; // their cell grids
 } tm_canvas;
 
 // Container Layout Mode,
@@ -32,6 +114,8 @@ typedef struct {
     layout_mode mode;
     int cursor_x, cursor_y;
     int container_w, container_h;  // ← NEW: active layout width for propagation
+    int origin_x, origin_y;        // where the container content starts
+    int extent_w, extent_h;        // content laid out so far, measured from the origin
 } layout_context;
 
 extern layout_context gui_context;
@@ -113,8 +197,11 @@ typedef struct {
 	tm_textstyle active;
 } tm_button_style;
 
+typedef struct { unsigned char slot; } tm_atlas; // a glyph sheet from tm_load_atlas, zeroed = the default sheet
+
 typedef struct {
     Font font;
+    tm_atlas atlas; // sheet for tm_draw_glyph and panels
     tm_textstyle text;
     tm_textstyle label;
     tm_panel_style panel;
@@ -168,14 +255,62 @@ static const tm_theme THEME_GREEN = {
     }
 };
 
+// --- Render Backends ---
+// tm_canvas_end diffs the cell grid and hands only the changed cells to the active backend:
+// begin, fill_span for each run of changed backgrounds, blit_glyph for each changed glyph, end, then present.
+typedef struct tm_backend {
+	const char *name;
+	void (*canvas_init)(tm_canvas *c);                    // create per-canvas targets (optional), slot = -1 refuses it
+	void (*canvas_unload)(tm_canvas *c);                  // (optional)
+	void (*begin)(tm_canvas *c);
+	void (*fill_span)(int x, int y, int len, Color bg);   // len cells from x,y, replaces pixels incl. alpha
+	void (*blit_glyph)(int x, int y, const tm_cell *cell); // over the already filled cell, after all spans
+	void (*end)(tm_canvas *c);
+	void (*present)(tm_canvas *c);                        // show the finished canvas (optional)
+} tm_backend;
+
+extern const tm_backend TM_BACKEND_RAYLIB; // default, RenderTexture per canvas upscaled to the window
+extern const tm_backend TM_BACKEND_SOFT;   // CPU, into the buffer given to tm_soft_set_target
+extern const tm_backend TM_BACKEND_NULL;   // renders nothing, counts operations
+extern const tm_backend TM_BACKEND_TERM;   // ANSI terminal, see Terminal Backend
+
+typedef struct { long long frames, spans, span_cells, glyphs, presents; } tm_null_counts;
+
+// --- Frame Stats ---
+// Counters for one canvas frame (tm_canvas_begin .. tm_canvas_end)
+typedef struct {
+	int widgets;          // elements laid out (tm_text, tm_label, tm_panel, ...)
+	int cells_written;    // cell writes by the draw primitives
+	int cells_drawn;      // changed cells handed to the backend
+	int anim_cells;       // cells showing an animated tile, the only ones checked when the layout did not change
+	int glyph_blits;
+	int bg_fills;         // background spans
+	int texture_switches; // texture binds by the raylib backend
+	int text_chars;
+	int upscale_blits;    // canvas to window blits
+	float frame_ms;
+} tm_stats;
+
 // --- Core Layout API ---
 void tm_vbox(grect area);
 void tm_hbox(grect area);
 grect tm_next_cell(int w, int h);
 
+// Nested containers: begin pushes a box into the current one, tm_box_end pops back to the parent.
+// Positioned like an element. An AUTO dimension is the content size measured in the previous frame (so
+// the layout code runs once per frame and settles a frame later), stretched to the parent like an
+// element would be: across a parent vbox, down a parent hbox. tm_set_padding insets the content on all sides.
+// Returns the box rect, e.g. to draw a tm_panel around the content before laying it out.
+grect tm_vbox_begin(grect area);
+grect tm_hbox_begin(grect area);
+grect tm_box_end(void); // rect of the content laid out in the box, this frame
+
 // --- System Init ---
-void tmgui_init(int cell_w, int cell_h);
+bool tmgui_init(int cell_w, int cell_h); // false (and logged) when the built-in font or glyph sheet is missing
 void tmgui_shutdown(void);
+Font tm_load_font(const char *path); // lazy: read (or taken from embedded assets) when first drawn, no UnloadFont
+tm_atlas tm_load_atlas(const char *path); // glyph sheet, lazy like tm_load_font
+void tm_set_atlas(const tm_atlas *atlas); // per-element sheet override like tm_set_font, NULL = the themes
 void tm_set_theme(const tm_theme *theme);
 void tm_set_font(Font *font);
 void tm_align_horizontal(align_mode mode);
@@ -183,6 +318,15 @@ void tm_align_vertical(align_mode mode);
 void tm_set_spacing(int spacing);
 void tm_set_padding(int padding);
 
+// --- Async Assets ---
+// Font rasterizing and PNG decoding run on a worker thread, the finished page is uploaded at the next
+// tm_canvas_begin. Until then the old page keeps drawing, text in a font with no page yet uses the fallback.
+// Build with -DTM_NO_THREADS to run the jobs inline (still installed at the next frame boundary).
+Font tm_load_font_async(const char *path); // tm_load_font, baked on the worker now instead of on first draw
+tm_atlas tm_load_atlas_async(const char *path); // tm_load_atlas, decoded on the worker now
+void tm_watch_assets(bool enabled);         // hot reload: re-read loaded fonts / the glyph sheet when their file changes
+int tm_assets_pending(void);                // loads queued or not yet installed, e.g. for a loading screen
+
 // --- Primitives 'tm_draw' ---
 void tm_draw_fill_cell(grect cell, Color color);
 void tm_draw_fill_rect(grect area, Color color);
@@ -190,6 +334,11 @@ void tm_draw_glyph(grect cell, atlaspos tile, Color fg, Color bg);
 void tm_draw_panel(grect r);
 void tm_draw_text(const char *text, grect cell, Color fg, Color bg);
 
+// --- Deferred Drawing (opt-in) ---
+// Primitives are recorded and replayed in tm_canvas_end ordered by layer, call order kept within a layer.
+void tm_set_deferred(bool deferred);
+void tm_set_layer(int layer); // 0 (bottom) .. TM_MAX_LAYERS - 1, on a layered canvas also its layer
+
 // ALIGNMENT HELPER: Now returns a grect (CELL)
 grect tm_align_text_pos(grect container, int text_width_in_cells, int text_height_in_cells);
 
@@ -200,15 +349,192 @@ grect tm_label(const char *text, grect area);
 grect tm_panel(grect area);
 grect tm_label_panel(const char *text, grect area, int text_nudge_x);
 grect tm_panel_titled (const char *text, grect area, int pad);
+bool tm_button(const char *label, grect area); // true on release over the button it was pressed on
+
+// --- Log ---
+// Scrolling message log over a caller owned ring buffer of capacity lines, line_len bytes each.
+// Pushing is O(1) and overwrites the oldest line once full. tm_log word wraps to the area width and
+// only lays out the rows that fit, newest at the bottom, so its cost does not grow with the history.
+// Mouse wheel / page up / page down / end scroll it while hovered.
+typedef struct {
+    char *text;          // capacity * line_len bytes
+    int capacity, line_len;
+    int head, count;     // next slot to write, lines held
+    int scroll;          // lines scrolled back from the newest, 0 follows new lines
+} tm_log_buffer;
+
+void tm_log_init(tm_log_buffer *log, char *storage, int capacity, int line_len);
+void tm_log_push(tm_log_buffer *log, const char *line); // longer lines are cut to line_len - 1
+void tm_log_clear(tm_log_buffer *log);
+grect tm_log(tm_log_buffer *log, grect area);
+
+// --- List / Table ---
+// Virtualized: the row callback only runs for the rows inside the area, so item count does not matter.
+// The selected row gets the label background before its callback. While hovered the wheel scrolls and
+// click selects. A click on the list also gives it the keys until a click lands elsewhere (tm_active of
+// its ID): up/down/page up/page down/home/end move the selection. A scrollbar takes the last column when
+// there are more rows than fit. Each callback runs inside tm_push_id_int(row).
+#ifndef TM_MAX_COLUMNS
+#define TM_MAX_COLUMNS 16
+#endif
+
+typedef struct {
+    int first;     // first visible row
+    int selected;  // -1 for none
+} tm_list_state;
+
+typedef struct {
+    const char *title;
+    int width;     // cells, <= 0 takes what is left
+} tm_column;
+
+typedef void (*tm_list_row_fn)(int row, grect area, void *user);
+typedef void (*tm_table_row_fn)(int row, const grect *cols, int col_count, void *user); // one cell rect per column
+
+grect tm_list(tm_list_state *state, int count, int row_h, tm_list_row_fn draw_row, void *user, grect area);
+grect tm_table(tm_list_state *state, const tm_column *cols, int col_count, int count, tm_table_row_fn draw_row, void *user, grect area); // header + 1 cell high rows
+
+// --- Widget IDs ---
+// Widgets are identified by a hash of their label and the enclosing ID scope: the canvas, the
+// current vbox/hbox and whatever was pushed. The same label twice in one scope is told apart by call
+// order. The ID keys retained per-widget state (hover/active, cached layout), kept across frames. Plain
+// tm_text has no ID or state, it is laid out from scratch every frame.
+typedef unsigned int tm_id;
+
+void tm_push_id(const char *str);
+void tm_push_id_int(int n);  // e.g. the row index inside a tm_list callback
+void tm_pop_id(void);
+tm_id tm_get_id(const char *label); // the ID a widget with this label would get in the current scope
+tm_id tm_last_id(void);             // ID of the most recent widget
+bool tm_hovered(tm_id id);          // as of the widgets last layout
+bool tm_active(tm_id id);           // pressed and still held, lists: has the keys
+
+// Hit testing goes through a per-canvas grid_w x grid_h map of the topmost widget ID per cell. Labels,
+// buttons, panels, logs and lists write it as they are laid out (later or higher tm_set_layer wins), so
+// hover is one lookup and overlapping widgets agree on who is on top. Hover lags the map by one frame.
+tm_id tm_hover_id(void);                               // topmost widget under the mouse, 0 for none
+tm_id tm_owner_at(const tm_canvas *c, int x, int y);   // after tm_canvas_end, from its finished map
 
 // --- Mouse Input / Transform ---
+// The widgets read input from one snapshot per frame, taken by the first tm_canvas_begin of the frame: from
+// raylib (or the terminal), or injected. Injected / scripted snapshots replace the devices entirely, so
+// hover, clicks, scrolling and keys can be driven headless and deterministically, e.g. in benchmarks.
+typedef struct {
+    float frame_time;           // seconds
+    Vector2 mouse;              // tm_mouse_grid, in cells (1/16 cell resolution in recordings)
+    unsigned char buttons;      // held, bit n = MOUSE_BUTTON n. Pressed / released are the change from last frame
+    float wheel;
+    int key_count;
+    int keys[TM_INPUT_KEYS];    // pressed or repeated this frame
+    unsigned int key_repeat;    // bit i: keys[i] is an auto repeat, not a press
+} tm_input;
+
 void tm_update_transform(int scale, int offX, int offY);
 Vector2 tm_mouse_grid(void);
+void tm_input_inject(const tm_input *in);                 // the next frame's snapshot, instead of the devices
+void tm_input_script(const tm_input *frames, int count); // one snapshot per frame from the next one on, NULL stops
+int tm_input_script_left(void);                          // frames of the script not used yet
+const tm_input *tm_input_get(void);                      // this frame's snapshot
+bool tm_key_pressed(int key);                            // in this frame's snapshot, repeats not included
+bool tm_mouse_pressed(int button);
+bool tm_mouse_released(int button);
 
 // --- Canvas Abstraction ---
 tm_canvas tm_canvas_init(int grid_w, int grid_h, bool transparent);
 void tm_canvas_begin(tm_canvas *c);
 void tm_canvas_end(tm_canvas *c);
+void tm_canvas_unload(tm_canvas *c);
+void tm_canvas_invalidate(tm_canvas *c); // force every cell to re-render next frame
+const tm_cell *tm_canvas_cells(const tm_canvas *c); // last completed frame, grid_w * grid_h row-major
+                                                     // (TM_PALETTE_CELLS: an expanded copy, valid until the next call)
+
+// --- Canvas Layers ---
+// Layer 0 is the canvas itself, named layers stack on top of it in the order they were added. Each has
+// its own cells, target and frame hash, so tm_canvas_end only re-renders layers whose primitives changed
+// and then composites them all. tm_set_layer(n) picks the layer the primitives write to.
+int tm_canvas_add_layer(tm_canvas *c, const char *name, bool transparent); // layer index, -1 if no grid was free
+int tm_canvas_layer(const tm_canvas *c, const char *name);                 // -1 if there is none
+const tm_canvas *tm_canvas_get_layer(const tm_canvas *c, int layer);      // the layer as a canvas of its own
+
+// --- Software Rasterizer (headless) ---
+// Renders the canvas' last completed frame into a caller owned RGBA8 buffer of
+// (grid_w * cell_w) x (grid_h * cell_h) pixels, layers composited. Works without a window.
+// TM_BACKEND_SOFT keeps one buffer per layer, set each with tm_soft_set_target(tm_canvas_get_layer(...)).
+// Large canvases are rendered in TM_RASTER_BAND row bands on a pool of TM_RASTER_THREADS workers, same pixels.
+int tm_soft_buffer_size(const tm_canvas *c);
+void tm_soft_render(const tm_canvas *c, unsigned char *rgba);
+bool tm_soft_export(const tm_canvas *c, unsigned char *rgba, const char *path); // render + ExportImage
+void tm_soft_set_target(const tm_canvas *c, unsigned char *rgba); // retained buffer for TM_BACKEND_SOFT
+
+// --- Terminal Backend ---
+// TM_BACKEND_TERM shows one canvas (layers composited, a second canvas is refused) at the top left of the
+// terminal, one character per cell: alternate screen, 24-bit or 256 colors, xterm mouse reports (position,
+// buttons, wheel) and typed keys (letters, digits, enter, tab, backspace, escape, arrows, home / end, page
+// up / down, insert / delete) as the input, in tm_input like raylib's. Each frame writes only the
+// cells that changed, an unchanged frame writes nothing. Font cells print their codepoint, glyph sheet cells go
+// through a per-atlas table (the default sheet has one built in), unmapped ones print as a middle dot.
+void tm_term_set_glyph_map(tm_atlas atlas, const unsigned short *codepoints, int count); // sheet cell -> Unicode (BMP), 0 = unmapped
+void tm_term_set_truecolor(bool enabled); // false: xterm 256 color cube
+void tm_term_set_writer(void (*write)(const char *bytes, int len, void *user), void *user); // NULL = stdout
+bool tm_term_size(int *cols, int *rows);  // terminal size in cells, e.g. for tm_canvas_init
+long long tm_term_bytes_written(bool reset);
+
+// --- Recording / Replay ---
+// tm_record_start streams a canvas' frames to a file: per layer only the cells that changed (run-length and
+// delta coded) plus that frame's input, a few bytes for a frame where little moved. tm_replay_* plays it back
+// through the active backend as fast as it is called, no window or UI code needed, e.g. for benchmarks.
+// Glyph pages are referenced by slot: the player loads the recorded fonts / sheets from the same paths.
+// tm_replay_inputs reads just the input track, to drive live UI code with tm_input_script.
+bool tm_record_start(const tm_canvas *c, const char *path); // the canvas and the layers it has now
+void tm_record_stop(void);
+bool tm_replay_open(const char *path, tm_canvas *c);        // c: a new canvas of the recorded size and layers
+bool tm_replay_frame(tm_canvas *c, tm_input *input);        // applies and renders the next frame, false at the end
+void tm_replay_close(void);
+int tm_replay_inputs(const char *path, tm_input *out, int max); // frames read, up to max
+
+// --- Backend Selection ---
+void tm_set_backend(const tm_backend *backend); // before tm_canvas_init, NULL restores raylib
+const tm_backend *tm_get_backend(void);
+tm_null_counts tm_null_backend_counts(bool reset);
+
+// --- Palette ---
+// TM_PAL(i) is palette entry i, usable anywhere a Color is (themes, styles, tm_draw_*). Entry 0 is transparent.
+// It is encoded as alpha 0 with a marker in g / b, any other alpha 0 color is plain transparent.
+// Build with -DTM_PALETTE_CELLS and cells store palette indices, 4 bytes instead of 12: tm_set_palette then
+// recolors every canvas (fades, flashes, theme swaps) without touching a cell. Literal colors (and translucent
+// fills blended over them) still work there: they are given entries from 255 down to above the highest one you
+// set, and entries unused for a few frames are recycled. The palette can run out: with more distinct colors on
+// screen at once than free entries, the rest snap to the nearest entry (logged once). Without TM_PALETTE_CELLS
+// TM_PAL entries resolve when drawn and literal colors never touch the palette.
+#define TM_PAL_MARK_G 0xA1
+#define TM_PAL_MARK_B 0x7E
+#define TM_PAL(i) CLITERAL(Color){ (unsigned char)(i), TM_PAL_MARK_G, TM_PAL_MARK_B, 0 }
+void tm_set_palette(int index, Color color);
+void tm_set_palette_range(int first, int count, const Color *colors);
+Color tm_get_palette(int index);
+
+// --- Animated Tiles ---
+// A sheet tile can be made to cycle through frames wherever it is drawn (tm_draw_glyph, panel kits). The frame
+// comes from one clock, advanced by each frame's tm_input frame_time, so every copy is in step and scripted
+// input replays them exactly. Cells keep the base tile: a layout that did not change still skips the diff,
+// only the cells showing animated tiles are checked and only those whose frame moved are redrawn.
+bool tm_animate_tile(tm_atlas atlas, atlaspos tile, const atlaspos *frames, int count, float frame_time); // count 0 removes, false if full
+double tm_anim_clock(void);              // seconds
+void tm_anim_set_clock(double seconds); // e.g. 0 to restart every animation
+void tm_clear_animations(void);         // removes every animated tile and restarts the clock, e.g. leaving a scene
+
+// --- Frame Pacing ---
+// tm_canvas_end skips rendering when the frame emitted the same primitives as the last one and only
+// re-blits the cached target. For an idle loop, EnableEventWaiting() and skip frames while
+// tm_frame_needed() is false. Animated tiles on screen keep it true, other animated content has to call
+// tm_request_frame() to keep frames coming.
+bool tm_frame_needed(void);   // input, resize, a request, animated tiles, or content changed last frame
+void tm_request_frame(void);  // force the next tm_frame_needed() to return true
+
+// --- Stats ---
+const tm_stats *tm_get_stats(void); // last completed canvas frame
+void tm_show_stats(bool show);      // overlay the counters in the canvas' top right corner
+bool tm_stats_shown(void);
 
 void glyph_tool(void);
 
@@ -1,8 +1,11 @@
 #include "tmgui.h"
+#include "rlgl.h"
 #include <string.h>
+#include <stdint.h>
 #include <math.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <time.h>
 
 // - Canvas/Grid
 static int cell_w, cell_h;
@@ -20,19 +23,276 @@ static align_mode v_align = ALIGN_TOP;
 static tm_theme current_theme;
 static Font current_font = {0};
 static Font fallback_font = {0};
-static Texture2D glyph_atlas;
+static Font devtool_font = {0}; // real raylib Font for the glyph tool, loaded when it first opens
+static Texture2D glyph_atlas; // glyph tool only, a copy of the sheet it shows
 
 // - Devtools
+#ifndef TMGUI_NO_DEMO
 static bool show_tilepicker = false;
+#endif
+
+// - Palette, TM_PAL(i) colors resolve through it. Entry 0 stays BLANK.
+static Color palette[256];
+#define IS_PAL(c) ((c).a == 0 && (c).g == TM_PAL_MARK_G && (c).b == TM_PAL_MARK_B) // else alpha 0 is just transparent
+#ifdef TM_PALETTE_CELLS
+#define PALETTE_STALE 1                        // frames a literal entry may go unused before it is recycled
+static int palette_next = 256;                 // literal colors get entries of their own, from 255 down
+static int palette_user_top = 1;               // above the highest entry tm_set_palette was given
+static unsigned int palette_used[256];         // palette_clock of each literal entry's last use
+static unsigned int palette_clock = 0;         // counts frames (input snapshots, see INPUT)
+#endif
+
+// - Retained cells. With TM_PALETTE_CELLS a cell is 4 bytes: the page in the top PCELL_PAGE_SHIFT bits of the
+// glyph and fg / bg as palette indices, expanded to a tm_cell for the backends. Otherwise it is the tm_cell.
+#ifdef TM_PALETTE_CELLS
+#define PCELL_PAGE_SHIFT 11 // 2048 glyphs per page, 32 pages
+#if 1 + TM_MAX_ATLASES + TM_MAX_FONTS > 32
+#error "TM_PALETTE_CELLS packs the page into 5 bits: TM_MAX_ATLASES + TM_MAX_FONTS must stay below 32"
+#endif
+typedef unsigned char cell_color;
+typedef struct { unsigned short glyph; cell_color fg, bg; } grid_cell;
+#else
+typedef Color cell_color;
+typedef tm_cell grid_cell;
+#endif
+
+#if TM_MAX_ANIMS > 256
+#error "TM_MAX_ANIMS must stay at or below 256, the grids keep an animation index per cell as a byte"
+#endif
+typedef struct {
+    grid_cell cells[TM_MAX_CELLS]; // this frame, written by the draw primitives
+    grid_cell shown[TM_MAX_CELLS]; // what the canvas target currently holds
+    bool in_use;
+    bool full_redraw;
+    uint64_t last_hash;          // frame hash of what the target holds
+    unsigned int owner[TM_MAX_CELLS];        // topmost widget ID per cell, written during layout (tm_id)
+    unsigned char owner_layer[TM_MAX_CELLS]; // draw layer of that widget
+    int anim_count;                          // cells showing an animated tile as of the last diff, ascending
+    int anim_cells[TM_MAX_ANIM_CELLS];
+    unsigned char anim_ids[TM_MAX_ANIM_CELLS]; // which animation each one shows
+    bool anim_warned;                          // TM_MAX_ANIM_CELLS overflow logged for this canvas
+} cell_grid;
+
+static cell_grid grids[TM_MAX_CANVASES];
+static grid_cell *cells = NULL; // active layer cells, NULL outside tm_canvas_begin/end
+static int cells_w, cells_h;
+
+// A color as the primitives take it, resolved once per call: rgba to test / blend, cell to store
+typedef struct { Color rgba; cell_color cell; } ink;
+
+#ifdef TM_PALETTE_CELLS
+static inline bool color_same(const Color *a, Color b) { return a->r == b.r && a->g == b.g && a->b == b.b && a->a == b.a; }
+
+// Literal colors are given an entry of their own, from 255 down to above the users entries. Once those run
+// out, an entry no canvas used this frame or the last is recycled (every grid redraws, cells that still
+// hold it are rewritten next frame anyway). Only with all of them in use does a color snap to the nearest.
+static unsigned char palette_index(Color c) {
+    static int last = 255;
+    if (IS_PAL(c)) return c.r;
+    if (c.a == 0) return 0; // transparent, entry 0
+    int lo = (palette_next > palette_user_top) ? palette_next : palette_user_top;
+    if (last >= lo && color_same(&palette[last], c)) { palette_used[last] = palette_clock; return (unsigned char)last; }
+    for (int i = 255; i >= lo; i--) {
+        if (!color_same(&palette[i], c)) continue;
+        palette_used[i] = palette_clock;
+        return (unsigned char)(last = i);
+    }
+    int slot = -1;
+    if (palette_next > palette_user_top) {
+        slot = --palette_next;
+    } else {
+        unsigned int oldest = 0;
+        for (int i = 255; i >= lo; i--) {
+            unsigned int age = palette_clock - palette_used[i];
+            if (age > PALETTE_STALE && age > oldest) { oldest = age; slot = i; }
+        }
+        if (slot >= 0) for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
+    }
+    if (slot >= 0) {
+        palette[slot] = c;
+        palette_used[slot] = palette_clock;
+        return (unsigned char)(last = slot);
+    }
+    static bool warned = false;
+    if (!warned) TraceLog(LOG_WARNING, "TMGUI: palette full, literal colors now snap to the nearest entry");
+    warned = true;
+    int best = 1, best_d = 1 << 30;
+    for (int i = 1; i < 256; i++) {
+        int dr = palette[i].r - c.r, dg = palette[i].g - c.g, db = palette[i].b - c.b, da = palette[i].a - c.a;
+        int d = dr * dr + dg * dg + db * db + da * da;
+        if (d < best_d) { best_d = d; best = i; }
+    }
+    return (unsigned char)best;
+}
+
+static inline ink ink_of(Color c) {
+    unsigned char index = palette_index(c);
+    return (ink){ palette[index], index };
+}
+static inline Color cell_rgba(cell_color c) { return palette[c]; }
+static inline unsigned char cell_page(const grid_cell *c) { return c->glyph >> PCELL_PAGE_SHIFT; }
+static inline unsigned short cell_glyph(const grid_cell *c) { return c->glyph & ((1 << PCELL_PAGE_SHIFT) - 1); }
+static inline void cell_set_glyph(grid_cell *c, unsigned char page, unsigned short glyph) {
+    c->glyph = (glyph >> PCELL_PAGE_SHIFT) ? 0 : (unsigned short)(page << PCELL_PAGE_SHIFT | glyph); // too far in, blank
+}
+static inline void cell_expand(const grid_cell *c, tm_cell *out) {
+    *out = (tm_cell){ c->glyph & ((1 << PCELL_PAGE_SHIFT) - 1), cell_page(c), 0, palette[c->fg], palette[c->bg] };
+}
+#else
+static inline ink ink_of(Color c) {
+    Color rgba = IS_PAL(c) ? palette[c.r] : c;
+    return (ink){ rgba, rgba };
+}
+static inline Color cell_rgba(cell_color c) { return c; }
+static inline void cell_set_glyph(grid_cell *c, unsigned char page, unsigned short glyph) {
+    c->page = page;
+    c->glyph = glyph;
+}
+static inline unsigned char cell_page(const grid_cell *c) { return c->page; }
+static inline unsigned short cell_glyph(const grid_cell *c) { return c->glyph; }
+static inline void cell_expand(const grid_cell *c, tm_cell *out) { *out = *c; }
+#endif
+
+// - Canvas layers, indexed by grid slot. Layer 0 is the users tm_canvas, these are the named ones over it
+static tm_canvas layer_views[TM_MAX_CANVASES];
+static char layer_names[TM_MAX_CANVASES][16];
+static tm_canvas *active_canvas = NULL;
+
+// - Glyph pages, grid aligned sheets of cell_w x cell_h glyphs: one per glyph sheet, then one baked page per font
+#define PAGE_COUNT (TM_PAGE_FONT + TM_MAX_FONTS)
+
+typedef struct {
+    Image image;       // CPU copy, source for the software rasterizer and the shared texture
+    int cols, count;
+} glyph_page;
+
+static glyph_page pages[PAGE_COUNT];
+static unsigned int page_generation = 0; // bumped when a loaded page is replaced, drops backend copies of pages
+
+// - Shared glyph texture: every loaded page packed into one grid of SHARED_COLS cells, so a flush binds one
+// texture however tile sets and fonts are mixed. Cells keep page + glyph, shared_base maps them into it.
+#define SHARED_COLS 64
+static Texture2D shared_texture;
+static int shared_base[PAGE_COUNT];
+static bool shared_dirty = false;
+
+// - Glyph sheets, atlas slot n is page TM_PAGE_ATLAS + n. Slot 0 is the default sheet (a zeroed tm_atlas)
+typedef struct {
+    char path[256];
+    bool loaded;   // on first use
+    bool pending;  // a worker job is loading it, see ASYNC ASSETS
+    long mod_time; // of the file, for tm_watch_assets
+} atlas_slot;
+
+static atlas_slot atlases[TM_MAX_ATLASES];
+static int atlas_count = 0;
+static int current_atlas = -1; // tm_set_atlas override, -1 = the themes
+
+// - Embedded assets (-DTMGUI_EMBED_ASSETS): pages pre-baked by tools/tm_bake.c into tm_assets.h, used instead
+// of the files when name and cell size match. No file I/O or TTF rasterization for them.
+typedef struct {
+    const char *name;             // path relative to TM_ASSET_DIR, e.g. "fonts/URSA.ttf"
+    int cell_w, cell_h;           // cell size it was baked for
+    int cols, count;              // grid page layout, as in glyph_page
+    const unsigned short *lut;    // fonts: codepoint -> cell, NULL for glyph sheets
+    const unsigned char *pixels;  // width * height * channels
+    int width, height, channels;  // channels 1 = alpha (white glyphs), 4 = RGBA
+} tm_embedded_asset;
+
+#ifdef TMGUI_EMBED_ASSETS
+#include "tm_assets.h" // TM_EMBEDDED_ASSETS[], TM_EMBEDDED_ASSET_COUNT
+#endif
+
+// - Fonts, font slot n is baked into page TM_PAGE_FONT + n
+typedef struct {
+    const GlyphInfo *glyphs;  // identifies the font
+    unsigned short lut[256];  // codepoint -> cell on the fonts page, 0 = blank
+    char path[256];           // tm_load_font fonts, baked on first use ("" = raylib Font, baked when registered)
+    bool baked;
+    bool pending;             // a worker job is baking it, see ASYNC ASSETS
+    long mod_time;            // of the file, for tm_watch_assets
+} font_slot;
+
+static font_slot fonts[TM_MAX_FONTS];
+static int font_count = 0;
+
+// - Frame change detection, FNV-1a over the primitives emitted between tm_canvas_begin/end, one per layer
+#define HASH_SEED 14695981039346656037ULL
+static uint64_t frame_hashes[TM_MAX_LAYERS];
+static inline uint64_t hash_bytes(uint64_t h, const void *data, size_t n) {
+    const unsigned char *p = data;
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 1099511628211ULL;
+    return h;
+}
+
+static bool content_changed = true; // last tm_canvas_end rendered something new
+static bool frame_requested = false;
+
+// - Backend
+static const tm_backend *backend = &TM_BACKEND_RAYLIB;
+
+// - Deferred draw list (opt-in): primitives record here, tm_canvas_end replays it by layer
+typedef enum { CMD_FILL, CMD_GLYPH, CMD_TEXT, CMD_PANEL } draw_cmd_type;
+
+typedef struct {
+    unsigned char type, layer;
+    unsigned char page;      // font (CMD_TEXT) or atlas (CMD_GLYPH, CMD_PANEL) page at record time
+    bool strip;              // CMD_PANEL: one row strip instead of a box
+    grect area;
+    Color fg, bg;
+    union {
+        unsigned short glyph;    // CMD_GLYPH
+        int text;                // CMD_TEXT: offset into cmd_text
+        unsigned short kit[9];   // CMD_PANEL: resolved atlas cells, rows top / middle / bottom
+    } u;
+} draw_cmd;
+
+static draw_cmd cmds[TM_MAX_COMMANDS];
+static int cmd_count = 0;
+static char cmd_text[TM_MAX_COMMAND_TEXT];
+static int cmd_text_used = 0;
+static bool deferred = false;
+static int draw_layer = 0;
+static void replay_draw_list(void);
+
+// - Input, see INPUT
+static tm_input input_now, input_prev; // this frame's snapshot and the one before, what pressed / released diff
+static void input_begin_frame(int canvas_slot);
+
+// - Recording, see RECORDING
+static FILE *rec_file = NULL;
+static bool record_frame_begin(const tm_canvas *c);
+static void record_cells(const tm_canvas *c, const int *dirty, int count);
+static void record_frame_end(void);
+
+// - Stats
+static tm_stats stats = {0};      // accumulating for the canvas frame in progress
+static tm_stats last_stats = {0}; // published by tm_canvas_end
+static bool show_stats = false;
 
 
 
 // --- GRIDTOOLS ---------------------------------------------------------------------------------------
 
+// - Terminal backend mouse, from xterm mouse reports (see Terminal backend). Overrides the raylib mouse once seen.
+static bool term_mouse_seen = false;
+static Vector2 term_mouse = { 0 };
+static unsigned char term_buttons = 0, term_clicked = 0; // held / pressed since the last sample, so a click
+static float term_wheel = 0.0f;                          // that fits in one read still shows for a frame
+static int term_keys[TM_INPUT_KEYS];                     // raylib KEY_* read from stdin since the last sample
+static int term_key_count = 0;
+
+// From the snapshot, so injected input moves the hover too
 Vector2 tm_mouse_grid(void) {
+    return input_now.mouse;
+}
+
+static Vector2 device_mouse_grid(void) {
+    if (term_mouse_seen) return term_mouse;
     Vector2 m = GetMousePosition();
-    float pixel_rect = (m.x - canvas_x) / (float)canvas_scale;
-    float py = (m.y - canvas_y) / (float)canvas_scale;
+    float scale = (canvas_scale > 0) ? (float)canvas_scale : 1.0f; // no canvas presented yet (headless)
+    float pixel_rect = (m.x - canvas_x) / scale;
+    float py = (m.y - canvas_y) / scale;
     return (Vector2){ pixel_rect / cell_w, py / cell_h };
 }
 
@@ -82,9 +342,238 @@ static inline grect rect_center_cell(grect area) {
     return CELL(area.x + area.w / 2, area.y + area.h / 2);
 }
 
-static grect get_area_and_txtpos(const char *text, grect area, grect *out_txtpos) { // THIS A BIT STINKY, ISSA BIG ONE. DOES A LOT
+
+// --- WIDGET IDS / STATE ---
+// IDs are FNV-1a of the label seeded with the top of the ID stack. State lives in a fixed open addressing
+// table (linear probing). Entries unused for a while are recycled on insert, never removed, so probe
+// chains stay intact.
+#define WIDGET_STALE_FRAMES 60
+
+typedef struct {
+    tm_id id;              // 0 = empty
+    unsigned int frame;    // widget_frame it was last laid out in
+    bool hovered, active;
+    short content_w, content_h;    // containers: content measured last frame
+    unsigned int claim, claim_end; // order it took its cells in the owner map, and where its children ended
+
+    // get_area_and_txtpos cache: reused while all of its inputs are unchanged
+    bool cached;
+    short txt_w;
+    unsigned char h_align, v_align;
+    grect area;
+    layout_context ctx;
+    grect final, txtpos;
+} widget_state;
+
+static widget_state widgets[TM_MAX_WIDGETS];
+static unsigned int widget_frame = 0;
+static tm_id id_stack[TM_ID_STACK_DEPTH];
+static int id_depth = 0;      // id_stack[0] is the canvas scope
+static int id_overflow = 0;   // pushes dropped past TM_ID_STACK_DEPTH, still to be popped
+static tm_id layout_scope = 0; // current vbox/hbox, counted per frame
+static int layout_seq = 0;
+static widget_state *last_widget = NULL;
+static grect mouse_cell;       // grid cell under the mouse, once per frame
+
+// Container stack of tm_vbox_begin / tm_hbox_begin
+typedef struct {
+    layout_context parent;
+    tm_id parent_scope;
+    widget_state *ws;  // keeps the measured content size across frames
+    grect area;        // as requested, -1 = AUTO
+} layout_frame;
+
+static layout_frame layout_stack[TM_MAX_NESTING];
+static int layout_depth = 0;
+static int layout_overflow = 0;        // begins dropped past TM_MAX_NESTING, still to be ended
+static bool layout_overflow_warned = false; // this frame
+
+// Owner map of the active canvas: every interactive widget writes its ID over its cells as it is laid out,
+// so at the end of the frame each cell holds the topmost one. Hover is the one lookup at the mouse cell.
+static tm_id *owners = NULL;
+static unsigned char *owner_layers = NULL;
+static tm_id hover_owner = 0;  // topmost widget under the mouse, from the canvas' previous frame
+static unsigned int claim_seq = 0;
+
+static tm_id id_hash(tm_id seed, const void *data, int len) {
+    const unsigned char *p = data;
+    tm_id h = seed ^ 2166136261u;
+    for (int i = 0; i < len; i++) h = (h ^ p[i]) * 16777619u;
+    return h ? h : 1; // 0 marks empty slots
+}
+
+static tm_id id_scope(void) {
+    return id_hash(id_stack[id_depth], &layout_scope, sizeof(layout_scope));
+}
+
+// Label hash and length in one pass
+static tm_id label_id(const char *label, int *len) {
+    tm_id h = id_scope() ^ 2166136261u;
+    int i = 0;
+    for (; label[i]; i++) h = (h ^ (unsigned char)label[i]) * 16777619u;
+    *len = i;
+    return h ? h : 1;
+}
+
+static widget_state *widget_find(tm_id id) {
+    for (int n = 0, i = id & (TM_MAX_WIDGETS - 1); n < TM_MAX_WIDGETS; n++, i = (i + 1) & (TM_MAX_WIDGETS - 1)) {
+        if (widgets[i].id == id) return &widgets[i];
+        if (widgets[i].id == 0) return NULL;
+    }
+    return NULL;
+}
+
+// Finds or claims the entry for id, NULL when the table is full of live widgets
+static widget_state *widget_get(tm_id id) {
+    widget_state *reuse = NULL;
+    for (int n = 0, i = id & (TM_MAX_WIDGETS - 1); n < TM_MAX_WIDGETS; n++, i = (i + 1) & (TM_MAX_WIDGETS - 1)) {
+        widget_state *w = &widgets[i];
+        if (w->id == id) return w;
+        if (!reuse && (w->id == 0 || widget_frame - w->frame > WIDGET_STALE_FRAMES)) reuse = w;
+        if (w->id == 0) break;
+    }
+    if (!reuse) {
+        static bool warned = false;
+        if (!warned) TraceLog(LOG_WARNING, "TMGUI: widget state table full (TM_MAX_WIDGETS = %d), widgets past it get no state", TM_MAX_WIDGETS);
+        warned = true;
+        return NULL;
+    }
+    *reuse = (widget_state){ .id = id };
+    return reuse;
+}
+
+// State for a widget laid out this frame. A repeated label in the same scope gets the next free variant.
+static widget_state *widget_begin(tm_id id) {
+    widget_state *w = widget_get(id);
+    for (tm_id n = 1; w && w->frame == widget_frame && n < 64; n++) w = widget_get(id_hash(id, &n, sizeof(n)));
+    if (w) { w->frame = widget_frame; w->hovered = false; }
+    last_widget = w;
+    return w;
+}
+
+static void widgets_new_frame(int canvas_slot) {
+    widget_frame++;
+    if (widget_frame == 0) memset(widgets, 0, sizeof(widgets)); // wrapped, forget everything
+    id_depth = 0;
+    id_overflow = 0;
+    id_stack[0] = id_hash(0, &canvas_slot, sizeof(canvas_slot));
+    layout_scope = 0;
+    layout_seq = 0;
+    last_widget = NULL;
+    Vector2 m = tm_mouse_grid();
+    mouse_cell = CELL((int)floorf(m.x), (int)floorf(m.y));
+
+    // Resolve hover against the finished map of last frame, then start a fresh one
+    cell_grid *g = &grids[canvas_slot];
+    bool inside = mouse_cell.x >= 0 && mouse_cell.y >= 0 && mouse_cell.x < cells_w && mouse_cell.y < cells_h;
+    hover_owner = inside ? g->owner[mouse_cell.y * cells_w + mouse_cell.x] : 0;
+    owners = g->owner;
+    owner_layers = g->owner_layer;
+    memset(owners, 0, sizeof(tm_id) * cells_w * cells_h);
+    memset(owner_layers, 0, cells_w * cells_h);
+    claim_seq = 0;
+}
+
+// Topmost under the mouse last frame. With children, also when one of the widgets it laid out inside is.
+static bool widget_hovered(const widget_state *ws, bool children) {
+    if (!ws || hover_owner == 0) return false;
+    if (hover_owner == ws->id) return true;
+    if (!children) return false;
+    const widget_state *o = widget_find(hover_owner);
+    return o && o->claim > ws->claim && o->claim <= ws->claim_end;
+}
+
+// Writes the widget's ID over its cells, unless a widget on a higher draw layer already holds them
+static void widget_claim(widget_state *ws, grect r) {
+    if (!ws || !owners) return;
+    ws->hovered = widget_hovered(ws, false);
+    ws->claim = ws->claim_end = ++claim_seq;
+    int x0 = r.x < 0 ? 0 : r.x, x1 = r.x + r.w > cells_w ? cells_w : r.x + r.w;
+    int y0 = r.y < 0 ? 0 : r.y, y1 = r.y + r.h > cells_h ? cells_h : r.y + r.h;
+    for (int y = y0; y < y1; y++) {
+        for (int i = y * cells_w + x0; i < y * cells_w + x1; i++) {
+            if (owner_layers[i] > draw_layer) continue;
+            owners[i] = ws->id;
+            owner_layers[i] = (unsigned char)draw_layer;
+        }
+    }
+}
+
+// Pushes past the top are dropped but counted, so their pops do not unwind the scopes below
+static void push_id(const void *data, int len) {
+    if (id_depth + 1 >= TM_ID_STACK_DEPTH) {
+        if (id_overflow++ == 0) TraceLog(LOG_WARNING, "TMGUI: ID stack overflow (TM_ID_STACK_DEPTH = %d)", TM_ID_STACK_DEPTH);
+        return;
+    }
+    id_stack[id_depth + 1] = id_hash(id_stack[id_depth], data, len);
+    id_depth++;
+}
+
+void tm_push_id(const char *str) {
+    push_id(str, (int)strlen(str));
+}
+
+void tm_push_id_int(int n) {
+    push_id(&n, sizeof(n));
+}
+
+void tm_pop_id(void) {
+    if (id_overflow > 0) id_overflow--;
+    else if (id_depth > 0) id_depth--;
+}
+
+tm_id tm_get_id(const char *label) {
+    int len;
+    return label_id(label, &len);
+}
+
+tm_id tm_last_id(void) {
+    return last_widget ? last_widget->id : 0;
+}
+
+bool tm_hovered(tm_id id) {
+    widget_state *w = widget_find(id);
+    return w && w->hovered;
+}
+
+bool tm_active(tm_id id) {
+    widget_state *w = widget_find(id);
+    return w && w->active;
+}
+
+tm_id tm_hover_id(void) {
+    return hover_owner;
+}
+
+tm_id tm_owner_at(const tm_canvas *c, int x, int y) {
+    if (c->slot < 0 || x < 0 || y < 0 || x >= c->grid_w || y >= c->grid_h) return 0;
+    return grids[c->slot].owner[y * c->grid_w + x];
+}
+
+static inline bool layout_equal(const layout_context *a, const layout_context *b) {
+    return a->mode == b->mode && a->cursor_x == b->cursor_x && a->cursor_y == b->cursor_y &&
+           a->container_w == b->container_w && a->container_h == b->container_h;
+}
+
+// retained: the element gets an ID and a state entry (hover, ownership, the layout cache). Plain text needs
+// none of that and stays out of the table, so screens full of it cannot crowd out the interactive widgets.
+static grect get_area_and_txtpos(const char *text, grect area, grect *out_txtpos, bool retained) { // THIS A BIT STINKY, ISSA BIG ONE. DOES A LOT
     
-    int txt_w = strlen(text); // Calculate text width in grid cells (optimized for monospaced fonts)
+    int txt_w; // Text width in grid cells (optimized for monospaced fonts), comes out of the ID hash
+    widget_state *ws = NULL;
+    if (retained) ws = widget_begin(label_id(text, &txt_w));
+    else { txt_w = (int)strlen(text); last_widget = NULL; }
+    stats.widgets++;
+
+    // Same label, area, alignment and layout cursor as last time: reuse the result, only the cursor moves
+    if (ws && ws->cached && ws->txt_w == txt_w && ws->h_align == h_align && ws->v_align == v_align &&
+        memcmp(&ws->area, &area, sizeof(grect)) == 0 && layout_equal(&ws->ctx, &gui_context)) {
+        if (area.x == -1 && area.y == -1) tm_next_cell(ws->final.w, ws->final.h);
+        ws->hovered = widget_hovered(ws, false);
+        *out_txtpos = ws->txtpos;
+        return ws->final;
+    }
+    layout_context ctx = gui_context; // inputs, before tm_next_cell moves the cursor
 
     // Determine widget's actual width (w):
     int w = (area.w > 0) ? area.w : // If area.w positive, use that value.
@@ -124,174 +613,2698 @@ static grect get_area_and_txtpos(const char *text, grect area, grect *out_txtpos
     
     *out_txtpos = tm_align_text_pos(final, txt_w, 1); // Calculate and store the aligned starting grid cell for the text within 'final' rect.
 
-    
-    return final; // Return the calculated overall bounding rectangle for the widget.
+    if (ws) {
+        ws->cached = true;
+        ws->txt_w = (short)txt_w;
+        ws->h_align = (unsigned char)h_align;
+        ws->v_align = (unsigned char)v_align;
+        ws->area = area;
+        ws->ctx = ctx;
+        ws->final = final;
+        ws->txtpos = *out_txtpos;
+        ws->hovered = widget_hovered(ws, false);
+    }
+    return final; // Return the calculated overall bounding rectangle for the widget.
+}
+
+
+// --- TRANSFORM HELPERS --------------------------------------------------------------------------
+
+void tm_update_transform(int scale, int pos_x, int pos_y) {
+    canvas_scale = scale;
+    canvas_x = pos_x;
+    canvas_y = pos_y;
+}
+
+
+// --- INIT ---------------------------------------------------------------------------------------
+
+// A page image changed: shared_pack rebuilds the shared texture before the next flush draws. No GPU work here
+static void page_mark_dirty(const glyph_page *page) {
+    if (page->image.data != NULL) shared_dirty = true;
+}
+
+// Main thread, outside texture mode. Pages are small (a few hundred glyphs), so any change repacks them all.
+static void shared_pack(void) {
+    if (!shared_dirty || !IsWindowReady()) return;
+    shared_dirty = false;
+
+    int total = 0;
+    for (int p = TM_PAGE_ATLAS; p < PAGE_COUNT; p++) {
+        shared_base[p] = total;
+        if (pages[p].image.data != NULL) total += pages[p].count;
+    }
+    if (total == 0) return;
+
+    Image sheet = GenImageColor(SHARED_COLS * cell_w, ((total + SHARED_COLS - 1) / SHARED_COLS) * cell_h, BLANK);
+    for (int p = TM_PAGE_ATLAS; p < PAGE_COUNT; p++) {
+        const glyph_page *page = &pages[p];
+        if (page->image.data == NULL) continue;
+        for (int g = 0; g < page->count; g++) { // pages are RGBA8, one memcpy per glyph row
+            int sx = (g % page->cols) * cell_w, sy = (g / page->cols) * cell_h;
+            int d = shared_base[p] + g, dx = (d % SHARED_COLS) * cell_w, dy = (d / SHARED_COLS) * cell_h;
+            for (int y = 0; y < cell_h; y++)
+                memcpy((Color *)sheet.data + (dy + y) * sheet.width + dx,
+                       (const Color *)page->image.data + (sy + y) * page->image.width + sx, cell_w * sizeof(Color));
+        }
+    }
+
+    if (shared_texture.id != 0 && shared_texture.width == sheet.width && shared_texture.height == sheet.height) {
+        UpdateTexture(shared_texture, sheet.data);
+    } else {
+        UnloadTexture(shared_texture);
+        shared_texture = LoadTextureFromImage(sheet);
+        SetTextureFilter(shared_texture, TEXTURE_FILTER_POINT);
+    }
+    UnloadImage(sheet);
+}
+
+// Bakes codepoints 0..255 of a font into a grid aligned page, one cell per distinct glyph (cell 0 stays blank).
+// Glyphs are placed the way DrawTextCodepoint places them and clipped to their cell, so text then renders
+// exactly like atlas tiles: one lookup, one grid aligned quad.
+static void bake_font(glyph_page *page, font_slot *slot, Font font) {
+    int glyph_of[256];
+    int count = 1;
+
+    memset(slot->lut, 0, sizeof(slot->lut));
+    for (int cp = 33; cp < 256 && font.glyphs; cp++) { // controls and space stay blank
+        glyph_of[cp] = GetGlyphIndex(font, cp); // unknown codepoints resolve to the fonts fallback glyph
+        for (int prev = 33; prev < cp && !slot->lut[cp]; prev++)
+            if (glyph_of[prev] == glyph_of[cp]) slot->lut[cp] = slot->lut[prev];
+        if (!slot->lut[cp]) slot->lut[cp] = count++;
+    }
+
+    page->cols = 16;
+    page->count = count;
+    page->image = GenImageColor(page->cols * cell_w, ((count + page->cols - 1) / page->cols) * cell_h, BLANK);
+    Color *px = (Color *)page->image.data;
+    float scale = (float)cell_h / font.baseSize;
+
+    bool baked[257] = { false };
+    for (int cp = 33; cp < 256 && font.glyphs; cp++) {
+        if (baked[slot->lut[cp]]) continue;
+        baked[slot->lut[cp]] = true;
+        GlyphInfo gi = font.glyphs[glyph_of[cp]];
+        if (gi.image.data == NULL) continue;
+        bool gray = (gi.image.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE); // LoadFontData, else atlas GRAY_ALPHA
+        int cx = (slot->lut[cp] % page->cols) * cell_w, cy = (slot->lut[cp] / page->cols) * cell_h;
+
+        for (int y = 0; y < cell_h; y++) {
+            int iy = (int)((y - gi.offsetY * scale) / scale);
+            if (iy < 0 || iy >= gi.image.height) continue;
+            for (int x = 0; x < cell_w; x++) {
+                int ix = (int)((x - gi.offsetX * scale) / scale);
+                if (ix < 0 || ix >= gi.image.width) continue;
+                Color p = GetImageColor(gi.image, ix, iy);
+                px[(cy + y) * page->image.width + cx + x] = (Color){ 255, 255, 255, gray ? p.r : p.a };
+            }
+        }
+    }
+}
+
+// Embedded page for a path, when one was baked at the current cell size
+static const tm_embedded_asset *embedded_asset(const char *path) {
+#ifdef TMGUI_EMBED_ASSETS
+    size_t len = strlen(path);
+    for (int i = 0; i < TM_EMBEDDED_ASSET_COUNT; i++) {
+        const tm_embedded_asset *a = &TM_EMBEDDED_ASSETS[i];
+        size_t n = strlen(a->name);
+        if (a->cell_w == cell_w && a->cell_h == cell_h && n <= len && strcmp(path + len - n, a->name) == 0) return a;
+    }
+#else
+    (void)path;
+#endif
+    return NULL;
+}
+
+static void embedded_page(glyph_page *page, const tm_embedded_asset *a) { // CPU only, like bake_font
+    page->cols = a->cols;
+    page->count = a->count;
+    page->image = GenImageColor(a->width, a->height, BLANK);
+    Color *px = (Color *)page->image.data;
+    for (int i = 0; i < a->width * a->height; i++)
+        px[i] = (a->channels == 1) ? (Color){ 255, 255, 255, a->pixels[i] }
+                                   : (Color){ a->pixels[i * 4], a->pixels[i * 4 + 1], a->pixels[i * 4 + 2], a->pixels[i * 4 + 3] };
+}
+
+// CPU glyph data only (no GL texture), which is all the baking needs
+static Font load_font_data(const char *path) {
+    Font font = { 0 };
+    int size = 0;
+    unsigned char *data = LoadFileData(path, &size);
+    if (data) {
+        font.baseSize = cell_h;
+        font.glyphCount = 95; // LoadFontData default set, codepoints 32..126
+        font.glyphs = LoadFontData(data, size, cell_h, NULL, 0, FONT_DEFAULT);
+        UnloadFileData(data);
+    }
+    return font;
+}
+
+// The CPU side of loading a page: its embedded copy, else read the file (and bake it, for fonts).
+// No GL calls and no shared state, so the asset worker runs these too. False when the file couldnt be read.
+static bool build_font_page(glyph_page *page, font_slot *slot, const char *path, bool embedded) {
+    const tm_embedded_asset *a = embedded ? embedded_asset(path) : NULL;
+    if (a && a->lut) {
+        memcpy(slot->lut, a->lut, sizeof(slot->lut));
+        embedded_page(page, a);
+        return true;
+    }
+    Font font = load_font_data(path);
+    bake_font(page, slot, font);
+    UnloadFontData(font.glyphs, font.glyphCount);
+    return font.glyphs != NULL;
+}
+
+static bool build_sheet_page(glyph_page *page, const char *path, bool embedded) {
+    const tm_embedded_asset *a = embedded ? embedded_asset(path) : NULL;
+    if (a) {
+        embedded_page(page, a);
+        return true;
+    }
+    page->image = LoadImage(path);
+    ImageFormat(&page->image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    page->cols = page->image.width / cell_w;
+    if (page->cols < 1) page->cols = 1;
+    page->count = page->cols * (page->image.height / cell_h);
+    return page->image.data != NULL;
+}
+
+// First use of a tm_load_font font: its embedded page, else load the file, bake it and drop the glyph data
+static void font_slot_bake(int i) {
+    font_slot *slot = &fonts[i];
+    glyph_page *page = &pages[TM_PAGE_FONT + i];
+    slot->baked = true; // once, a missing file leaves a blank page
+
+    if (!build_font_page(page, slot, slot->path, true)) TraceLog(LOG_WARNING, "TMGUI: could not load font %s", slot->path);
+    page_mark_dirty(page);
+}
+
+static unsigned char font_page(Font font) { // cell page for a font, baking it on first use
+    static int last = 0;
+    int i = -1;
+    if (last < font_count && fonts[last].glyphs == font.glyphs) i = last;
+    for (int f = 0; i < 0 && f < font_count; f++) {
+        if (fonts[f].glyphs == font.glyphs) i = f;
+    }
+    if (i < 0) { // a raylib Font: register it, baked from its own glyphs right away
+        if (font_count == TM_MAX_FONTS) {
+            TraceLog(LOG_WARNING, "TMGUI: font page limit (%d) reached, using fallback font", TM_MAX_FONTS);
+            return TM_PAGE_FONT;
+        }
+        i = font_count++;
+        fonts[i] = (font_slot){ .glyphs = font.glyphs, .baked = true };
+        bake_font(&pages[TM_PAGE_FONT + i], &fonts[i], font);
+        page_mark_dirty(&pages[TM_PAGE_FONT + i]);
+    }
+    if (!fonts[i].baked) {
+        if (fonts[i].pending && i != 0) return font_page(fallback_font); // baking on the worker, slot 0 is the fallback
+        if (!fonts[i].pending) font_slot_bake(i);
+    }
+    last = i;
+    return TM_PAGE_FONT + i;
+}
+
+// Registers a font file, nothing is read until text is first drawn with it (then its embedded page is
+// used when there is one). The returned Font is a handle for tm_set_font / themes, it has no glyph data
+// for raylib's own text functions and must not be passed to UnloadFont. Loading the same path again
+// returns the same handle.
+Font tm_load_font(const char *path) {
+    Font font = { 0 };
+    font.baseSize = cell_h;
+
+    for (int i = 0; i < font_count; i++) {
+        if (strcmp(fonts[i].path, path) == 0) { font.glyphs = (GlyphInfo *)fonts[i].glyphs; return font; }
+    }
+    if (font_count == TM_MAX_FONTS) {
+        TraceLog(LOG_WARNING, "TMGUI: font page limit (%d) reached, %s not loaded", TM_MAX_FONTS, path);
+        return font;
+    }
+    static GlyphInfo handles[TM_MAX_FONTS]; // the handle only needs a unique glyphs pointer
+    font.glyphs = &handles[font_count];
+    font_slot *slot = &fonts[font_count++];
+    *slot = (font_slot){ .glyphs = font.glyphs };
+    snprintf(slot->path, sizeof(slot->path), "%s", path);
+    return font;
+}
+
+// Registers a glyph sheet, read on first use like tm_load_font. Loading the same path again returns the same handle.
+tm_atlas tm_load_atlas(const char *path) {
+    for (int i = 0; i < atlas_count; i++) {
+        if (strcmp(atlases[i].path, path) == 0) return (tm_atlas){ (unsigned char)i };
+    }
+    if (atlas_count == TM_MAX_ATLASES) {
+        TraceLog(LOG_WARNING, "TMGUI: atlas limit (%d) reached, %s not loaded", TM_MAX_ATLASES, path);
+        return (tm_atlas){ 0 };
+    }
+    atlases[atlas_count] = (atlas_slot){ 0 };
+    snprintf(atlases[atlas_count].path, sizeof(atlases[atlas_count].path), "%s", path);
+    return (tm_atlas){ (unsigned char)atlas_count++ };
+}
+
+static glyph_page *atlas_page(int slot) { // loads a glyph sheet on first use
+    atlas_slot *a = &atlases[slot];
+    glyph_page *page = &pages[TM_PAGE_ATLAS + slot];
+    if (a->loaded || a->pending) return page; // pending: blank (cols 0) until the worker is done
+    a->loaded = true;
+
+    if (!build_sheet_page(page, a->path, true)) TraceLog(LOG_WARNING, "TMGUI: could not load glyph sheet %s", a->path);
+    page_mark_dirty(page);
+    return page;
+}
+
+static unsigned char atlas_active_page(void) { // tm_set_atlas override, else the themes sheet
+    int slot = (current_atlas >= 0) ? current_atlas : current_theme.atlas.slot;
+    return TM_PAGE_ATLAS + ((slot < atlas_count) ? slot : 0);
+}
+
+// --- THREADS ---
+// Just what the asset worker needs: a thread, a lock and a condition variable. windows.h clashes with raylib
+// (Rectangle, CloseWindow, ...), so the few kernel32 calls are declared here. TM_NO_THREADS runs jobs inline.
+#ifndef TM_NO_THREADS
+#if defined(_WIN32)
+#include <process.h>
+typedef struct { void *ptr; } sync_lock; // SRWLOCK
+typedef struct { void *ptr; } sync_cond; // CONDITION_VARIABLE
+#define SYNC_LOCK_INIT { 0 }
+#define SYNC_COND_INIT { 0 }
+__declspec(dllimport) void __stdcall AcquireSRWLockExclusive(sync_lock *lock);
+__declspec(dllimport) void __stdcall ReleaseSRWLockExclusive(sync_lock *lock);
+__declspec(dllimport) int __stdcall SleepConditionVariableSRW(sync_cond *cond, sync_lock *lock, unsigned long ms, unsigned long flags);
+__declspec(dllimport) void __stdcall WakeAllConditionVariable(sync_cond *cond);
+__declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void *handle, unsigned long ms);
+__declspec(dllimport) int __stdcall CloseHandle(void *handle);
+
+typedef struct { uintptr_t handle; void (*fn)(void *); void *arg; } sync_thread;
+static unsigned __stdcall thread_entry(void *t) { ((sync_thread *)t)->fn(((sync_thread *)t)->arg); return 0; }
+static bool thread_start(sync_thread *t) { t->handle = _beginthreadex(NULL, 0, thread_entry, t, 0, NULL); return t->handle != 0; }
+static void thread_join(sync_thread *t) { WaitForSingleObject((void *)t->handle, 0xFFFFFFFF); CloseHandle((void *)t->handle); }
+static void lock(sync_lock *l) { AcquireSRWLockExclusive(l); }
+static void unlock(sync_lock *l) { ReleaseSRWLockExclusive(l); }
+static void cond_wait(sync_cond *c, sync_lock *l) { SleepConditionVariableSRW(c, l, 0xFFFFFFFF, 0); }
+static void cond_wake(sync_cond *c) { WakeAllConditionVariable(c); }
+#else
+#include <pthread.h>
+typedef pthread_mutex_t sync_lock;
+typedef pthread_cond_t sync_cond;
+#define SYNC_LOCK_INIT PTHREAD_MUTEX_INITIALIZER
+#define SYNC_COND_INIT PTHREAD_COND_INITIALIZER
+
+typedef struct { pthread_t handle; void (*fn)(void *); void *arg; } sync_thread;
+static void *thread_entry(void *t) { ((sync_thread *)t)->fn(((sync_thread *)t)->arg); return NULL; }
+static bool thread_start(sync_thread *t) { return pthread_create(&t->handle, NULL, thread_entry, t) == 0; }
+static void thread_join(sync_thread *t) { pthread_join(t->handle, NULL); }
+static void lock(sync_lock *l) { pthread_mutex_lock(l); }
+static void unlock(sync_lock *l) { pthread_mutex_unlock(l); }
+static void cond_wait(sync_cond *c, sync_lock *l) { pthread_cond_wait(c, l); }
+static void cond_wake(sync_cond *c) { pthread_cond_broadcast(c); }
+#endif
+#endif // TM_NO_THREADS
+
+// --- ASYNC ASSETS ---
+// Fonts are rasterized and sheets decoded on a worker thread (build_font_page / build_sheet_page), the
+// finished CPU page is swapped in and uploaded on the main thread at the next tm_canvas_begin. The page
+// being replaced keeps drawing until then, a font that has none yet draws with the fallback font.
+
+enum { JOB_FREE, JOB_QUEUED, JOB_RUNNING, JOB_DONE };
+
+typedef struct {
+    int state;                // guarded by asset_lock, the rest belongs to whoever moved it out of FREE/QUEUED
+    int page;                 // TM_PAGE_ATLAS + atlas slot or TM_PAGE_FONT + font slot
+    bool reload;              // hot reload: read the file even when an embedded copy exists
+    char path[256];
+    glyph_page result;        // CPU only, built on the worker
+    font_slot slot;           // fonts: the baked lut
+    bool ok;
+} asset_job;
+
+static asset_job asset_jobs[TM_MAX_ASYNC_JOBS];
+static int asset_jobs_active = 0; // not FREE, main thread only
+static bool assets_watching = false;
+
+#ifndef TM_NO_THREADS
+static sync_lock asset_lock = SYNC_LOCK_INIT;
+static sync_cond asset_cond = SYNC_COND_INIT;
+static sync_thread asset_thread;
+static bool asset_worker_running = false;
+static bool asset_worker_quit = false;
+#endif
+
+static void asset_job_run(asset_job *job) {
+    job->result = (glyph_page){ 0 };
+    if (job->page < TM_PAGE_FONT) job->ok = build_sheet_page(&job->result, job->path, !job->reload);
+    else job->ok = build_font_page(&job->result, &job->slot, job->path, !job->reload);
+}
+
+#ifndef TM_NO_THREADS
+static void asset_worker(void *arg) {
+    (void)arg;
+    lock(&asset_lock);
+    while (!asset_worker_quit) {
+        asset_job *job = NULL;
+        for (int i = 0; i < TM_MAX_ASYNC_JOBS && !job; i++) {
+            if (asset_jobs[i].state == JOB_QUEUED) job = &asset_jobs[i];
+        }
+        if (!job) { cond_wait(&asset_cond, &asset_lock); continue; }
+
+        job->state = JOB_RUNNING;
+        unlock(&asset_lock);
+        asset_job_run(job);
+        lock(&asset_lock);
+        job->state = JOB_DONE;
+    }
+    unlock(&asset_lock);
+}
+#endif
+
+// Queues a page load, false when the queue is full (the caller then loads it synchronously)
+static bool asset_queue(int page, const char *path, bool reload) {
+    asset_job *job = NULL;
+#ifndef TM_NO_THREADS
+    if (!asset_worker_running) {
+        asset_thread = (sync_thread){ .fn = asset_worker };
+        asset_worker_running = thread_start(&asset_thread);
+        if (!asset_worker_running) TraceLog(LOG_WARNING, "TMGUI: could not start the asset worker, loading synchronously");
+    }
+    if (!asset_worker_running) return false;
+    lock(&asset_lock);
+#endif
+    for (int i = 0; i < TM_MAX_ASYNC_JOBS; i++) {
+        if (asset_jobs[i].state == JOB_QUEUED && asset_jobs[i].page == page) { job = &asset_jobs[i]; break; } // not started, retarget
+        if (!job && asset_jobs[i].state == JOB_FREE) job = &asset_jobs[i];
+    }
+    if (job) {
+        if (job->state == JOB_FREE) asset_jobs_active++;
+        job->page = page;
+        job->reload = reload;
+        snprintf(job->path, sizeof(job->path), "%s", path);
+        job->state = JOB_QUEUED;
+    }
+#ifndef TM_NO_THREADS
+    cond_wake(&asset_cond);
+    unlock(&asset_lock);
+#else
+    if (job) { asset_job_run(job); job->state = JOB_DONE; }
+#endif
+    if (!job) TraceLog(LOG_WARNING, "TMGUI: async asset queue full (TM_MAX_ASYNC_JOBS = %d), loading %s synchronously", TM_MAX_ASYNC_JOBS, path);
+    return job != NULL;
+}
+
+// Main thread: swap a finished page in. A failed reload keeps the old page (e.g. a file caught mid-save).
+static void asset_install(asset_job *job) {
+    glyph_page *page = &pages[job->page];
+    font_slot *slot = (job->page >= TM_PAGE_FONT) ? &fonts[job->page - TM_PAGE_FONT] : NULL;
+    atlas_slot *sheet = slot ? NULL : &atlases[job->page - TM_PAGE_ATLAS];
+    bool first = slot ? !slot->baked : !sheet->loaded;
+    if (slot) slot->pending = false;
+    else sheet->pending = false;
+
+    if (!job->ok) {
+        TraceLog(LOG_WARNING, "TMGUI: could not load %s", job->path);
+        if (!first) { UnloadImage(job->result.image); return; } // first load: blank page, same as a sync load
+    }
+    UnloadImage(page->image);
+    *page = job->result;
+    page_mark_dirty(page);
+    if (slot) {
+        memcpy(slot->lut, job->slot.lut, sizeof(slot->lut));
+        slot->baked = true;
+    } else {
+        sheet->loaded = true;
+    }
+
+    // Cells keep their page / glyph indices, so every canvas has to re-render with the new pixels
+    page_generation++;
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
+    tm_request_frame();
+}
+
+// Re-queues loaded fonts / the glyph sheet whose file changed. Mod times have one second resolution,
+// so checking more often than that buys nothing.
+static void assets_watch(void) {
+    static time_t last_check = 0;
+    time_t now = time(NULL);
+    if (now == last_check) return;
+    last_check = now;
+
+    for (int i = 0; i < font_count; i++) {
+        font_slot *slot = &fonts[i];
+        if (!slot->path[0] || !slot->baked || slot->pending) continue;
+        long t = GetFileModTime(slot->path);
+        if (t && slot->mod_time && t != slot->mod_time) slot->pending = asset_queue(TM_PAGE_FONT + i, slot->path, true);
+        if (t) slot->mod_time = t;
+    }
+    for (int i = 0; i < atlas_count; i++) {
+        atlas_slot *sheet = &atlases[i];
+        if (!sheet->loaded || sheet->pending) continue;
+        long t = GetFileModTime(sheet->path);
+        if (t && sheet->mod_time && t != sheet->mod_time) sheet->pending = asset_queue(TM_PAGE_ATLAS + i, sheet->path, true);
+        if (t) sheet->mod_time = t;
+    }
+}
+
+static void assets_poll(void) { // once per tm_canvas_begin
+    if (assets_watching) assets_watch();
+    while (asset_jobs_active > 0) {
+        asset_job done = { 0 };
+#ifndef TM_NO_THREADS
+        lock(&asset_lock);
+#endif
+        for (int i = 0; i < TM_MAX_ASYNC_JOBS && done.state != JOB_DONE; i++) {
+            if (asset_jobs[i].state != JOB_DONE) continue;
+            done = asset_jobs[i];
+            asset_jobs[i].state = JOB_FREE;
+            asset_jobs_active--;
+        }
+#ifndef TM_NO_THREADS
+        unlock(&asset_lock);
+#endif
+        if (done.state != JOB_DONE) break;
+        asset_install(&done);
+    }
+}
+
+static void assets_stop(void) {
+#ifndef TM_NO_THREADS
+    if (asset_worker_running) {
+        lock(&asset_lock);
+        asset_worker_quit = true;
+        cond_wake(&asset_cond);
+        unlock(&asset_lock);
+        thread_join(&asset_thread);
+        asset_worker_running = false;
+        asset_worker_quit = false;
+    }
+#endif
+    for (int i = 0; i < TM_MAX_ASYNC_JOBS; i++) {
+        if (asset_jobs[i].state == JOB_DONE) UnloadImage(asset_jobs[i].result.image);
+        asset_jobs[i].state = JOB_FREE;
+    }
+    asset_jobs_active = 0;
+    assets_watching = false;
+}
+
+// Same handle as tm_load_font, the page is baked on the worker right away instead of on first draw
+Font tm_load_font_async(const char *path) {
+    Font font = tm_load_font(path);
+    for (int i = 0; i < font_count; i++) {
+        font_slot *slot = &fonts[i];
+        if (slot->glyphs != font.glyphs) continue;
+        if (!slot->baked && !slot->pending) slot->pending = asset_queue(TM_PAGE_FONT + i, slot->path, false);
+        break;
+    }
+    return font;
+}
+
+tm_atlas tm_load_atlas_async(const char *path) {
+    tm_atlas atlas = tm_load_atlas(path);
+    atlas_slot *sheet = &atlases[atlas.slot];
+    if (!sheet->loaded && !sheet->pending) sheet->pending = asset_queue(TM_PAGE_ATLAS + atlas.slot, sheet->path, false);
+    return atlas;
+}
+
+void tm_watch_assets(bool enabled) {
+    assets_watching = enabled;
+}
+
+int tm_assets_pending(void) {
+    return asset_jobs_active;
+}
+
+// Cold start does no file I/O: the fallback font and the glyph sheet load when first drawn
+bool tmgui_init(int cell_width, int cell_height) {
+    cell_w = cell_width;
+    cell_h = cell_height;
+
+    fallback_font = tm_load_font(TM_ASSET_DIR "fonts/BESCII.ttf");
+    tm_load_atlas(TM_ASSET_DIR "glyphs/T_jpetscii.png"); // slot 0, the default sheet
+
+    // Only a stat, but without these every cell draws blank, so say so now rather than per glyph later
+    const char *builtin[2] = { TM_ASSET_DIR "fonts/BESCII.ttf", TM_ASSET_DIR "glyphs/T_jpetscii.png" };
+    bool found = true;
+    for (int i = 0; i < 2; i++) {
+        if (embedded_asset(builtin[i]) || FileExists(builtin[i])) continue;
+        found = false;
+        TraceLog(LOG_ERROR, "TMGUI: %s not found. Run from the directory holding fonts/ and glyphs/, build with "
+                 "-DTM_ASSET_DIR=\"path/\" or embed them (-DTMGUI_EMBED_ASSETS, see tools/tm_bake.c)", builtin[i]);
+    }
+
+    current_theme = THEME_GREEN;
+    current_theme.font = fallback_font;
+    return found;
+}
+
+static void raster_stop(void); // SOFTWARE RASTERIZER
+static void soft_pages_reset(void); // SOFTWARE RASTERIZER
+
+void tmgui_shutdown(void) {
+    assets_stop();
+    raster_stop();
+    for (int p = TM_PAGE_ATLAS; p < PAGE_COUNT; p++) {
+        UnloadImage(pages[p].image);
+        pages[p] = (glyph_page){ 0 };
+    }
+    UnloadTexture(shared_texture);
+    shared_texture = (Texture2D){ 0 };
+    shared_dirty = false;
+    UnloadTexture(glyph_atlas);
+    if (devtool_font.glyphs) UnloadTexture(devtool_font.texture); // glyphs / recs are static, see devtool_font_load
+    devtool_font = (Font){ 0 };
+    glyph_atlas = (Texture2D){ 0 };
+    atlas_count = 0;
+    current_atlas = -1;
+    font_count = 0;
+
+    // A later tmgui_init reuses page slots and canvas slots: nothing cached against the old ones may match
+    page_generation++;
+    soft_pages_reset();
+    for (int i = 0; i < TM_MAX_CANVASES; i++) {
+        grids[i].last_hash = 0;
+        grids[i].full_redraw = true;
+    }
+    tm_clear_animations();
+}
+
+static Font get_active_font(void) { // glyphs, not texture, so CPU-only fonts count too
+    if (current_font.glyphs != NULL) return current_font;
+    if (current_theme.font.glyphs != NULL) return current_theme.font;
+    return fallback_font;
+}
+
+
+// --- LAYOUT SETTERS ---------------------------------------------------------------------------------------
+
+void tm_set_theme(const tm_theme *theme) {
+    if (theme) current_theme = *theme;
+}
+
+void tm_set_atlas(const tm_atlas *atlas) {
+    current_atlas = atlas ? atlas->slot : -1;
+}
+
+void tm_set_font(Font *font) {
+    if (font && font->glyphs != NULL) {
+        current_font = *font;
+    } else {
+        current_font = current_theme.font;
+    }
+}
+
+// Every canvas re-renders with the new colors, their cells stay as they are
+void tm_set_palette(int index, Color color) {
+    if (index <= 0 || index > 255) return; // 0 stays transparent
+    palette[index] = color;
+#ifdef TM_PALETTE_CELLS
+    if (index >= palette_user_top) palette_user_top = index + 1; // literal colors stay above it
+#endif
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
+    tm_request_frame();
+}
+
+void tm_set_palette_range(int first, int count, const Color *colors) {
+    for (int i = 0; i < count; i++) tm_set_palette(first + i, colors[i]);
+}
+
+Color tm_get_palette(int index) {
+    return (index >= 0 && index <= 255) ? palette[index] : BLANK;
+}
+
+void tm_set_spacing(int spacing) {
+    layout_spacing = spacing;
+}
+
+void tm_set_padding(int padding) {
+    layout_padding = padding;
+}
+
+void tm_align_horizontal(align_mode mode) {
+    h_align = mode;
+}
+
+void tm_align_vertical(align_mode mode) {
+    v_align = mode;
+}
+
+// Returns a grect (CELL) for text starting point aligned inside rect
+grect tm_align_text_pos(grect container, int text_width_in_cells, int text_height_in_cells) {
+    int x = container.x; // padding now handled explicitly in caller
+    int y = container.y;
+
+    // Horizontal alignment
+    if (h_align == ALIGN_CENTER)
+        x = container.x + (container.w - text_width_in_cells) / 2;
+    else if (h_align == ALIGN_RIGHT)
+        x = container.x + container.w - text_width_in_cells;
+
+    // Vertical alignment
+    if (v_align == ALIGN_CENTER)
+        y = container.y + (container.h - text_height_in_cells) / 2;
+    else if (v_align == ALIGN_BOTTOM)
+        y = container.y + container.h - text_height_in_cells;
+
+    return CELL(x, y); // Return as a CELL grect
+}
+
+// --- ANIMATED TILES ---
+// A table of sheet tiles that cycle through frames, resolved when cells are diffed: the grids keep the base
+// tile in cells (so layout hashes do not change with time) and the frame on screen in shown. The full diff
+// lists the cells showing an animated tile, a frame whose layout matched only checks those.
+typedef struct {
+    unsigned char atlas;
+    atlaspos tile;
+    atlaspos frames[TM_MAX_ANIM_FRAMES];
+    int count;
+    float frame_time;
+} tile_anim;
+
+#define ANIM_TABLE (TM_MAX_ANIMS * 2)
+
+static tile_anim anims[TM_MAX_ANIMS];
+static int anim_count = 0;
+static double anim_clock = 0.0;               // advanced by each input snapshot's frame_time
+static bool anim_page[PAGE_COUNT];            // any animation on this page, the fast reject
+static unsigned int anim_keys[ANIM_TABLE];    // page << 16 | base glyph, open addressing, 0 = empty
+static unsigned char anim_slots[ANIM_TABLE];  // index into anims
+static unsigned short anim_now[TM_MAX_ANIMS]; // glyph of each ones current frame
+
+static void anim_invalidate(void) { // the table changed: every grid diffs again (no redraw unless cells differ)
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].last_hash = 0;
+}
+
+bool tm_animate_tile(tm_atlas atlas, atlaspos tile, const atlaspos *frames, int count, float frame_time) {
+    int a = 0;
+    while (a < anim_count && !(anims[a].atlas == atlas.slot && anims[a].tile.x == tile.x && anims[a].tile.y == tile.y)) a++;
+    anim_invalidate();
+    if (count <= 0 || !frames) { // remove
+        if (a < anim_count) anims[a] = anims[--anim_count];
+        return true;
+    }
+    if (a == TM_MAX_ANIMS) {
+        TraceLog(LOG_WARNING, "TMGUI: animated tile limit (%d) reached", TM_MAX_ANIMS);
+        return false;
+    }
+    if (count > TM_MAX_ANIM_FRAMES) {
+        TraceLog(LOG_WARNING, "TMGUI: animated tile has %d frames, only the first %d are used", count, TM_MAX_ANIM_FRAMES);
+        count = TM_MAX_ANIM_FRAMES;
+    }
+    tile_anim *anim = &anims[a];
+    anim->atlas = atlas.slot;
+    anim->tile = tile;
+    memcpy(anim->frames, frames, sizeof(atlaspos) * count);
+    anim->count = count;
+    anim->frame_time = (frame_time > 0.0f) ? frame_time : 1.0f;
+    if (a == anim_count) anim_count++;
+    return true;
+}
+
+double tm_anim_clock(void) {
+    return anim_clock;
+}
+
+void tm_anim_set_clock(double seconds) {
+    anim_clock = (seconds > 0.0) ? seconds : 0.0;
+}
+
+void tm_clear_animations(void) {
+    if (anim_count > 0) anim_invalidate();
+    anim_count = 0;
+    anim_clock = 0.0;
+}
+
+// Once per tm_canvas_end: each animation's current frame and the lookup by base tile. Sheets that are not
+// loaded yet (or still on the asset worker) are left out, no cell can show them.
+static void anim_update(void) {
+    memset(anim_page, 0, sizeof(anim_page));
+    memset(anim_keys, 0, sizeof(anim_keys));
+    for (int a = 0; a < anim_count; a++) {
+        const tile_anim *anim = &anims[a];
+        int page = TM_PAGE_ATLAS + ((anim->atlas < atlas_count) ? anim->atlas : 0);
+        int cols = pages[page].cols;
+        if (cols == 0) continue;
+        atlaspos frame = anim->frames[(long long)(anim_clock / anim->frame_time) % anim->count];
+        anim_now[a] = (unsigned short)(frame.y * cols + frame.x);
+
+        unsigned int key = (unsigned int)page << 16 | (unsigned int)(anim->tile.y * cols + anim->tile.x);
+        unsigned int h = (key * 2654435761u) % ANIM_TABLE;
+        while (anim_keys[h] != 0 && anim_keys[h] != key) h = (h + 1) % ANIM_TABLE;
+        anim_keys[h] = key;
+        anim_slots[h] = (unsigned char)a;
+        anim_page[page] = true;
+    }
+}
+
+static int anim_find(const grid_cell *c) { // animation shown by this cell, -1 for none
+    unsigned char page = cell_page(c);
+    if (!anim_page[page]) return -1;
+    unsigned int key = (unsigned int)page << 16 | cell_glyph(c);
+    for (unsigned int h = (key * 2654435761u) % ANIM_TABLE; anim_keys[h] != 0; h = (h + 1) % ANIM_TABLE)
+        if (anim_keys[h] == key) return anim_slots[h];
+    return -1;
+}
+
+// --- Canvas ---
+static int grid_alloc(int grid_w, int grid_h) {
+    if (grid_w * grid_h > TM_MAX_CELLS) {
+        TraceLog(LOG_WARNING, "TMGUI: canvas %dx%d exceeds TM_MAX_CELLS (%d)", grid_w, grid_h, TM_MAX_CELLS);
+        return -1;
+    }
+    for (int i = 0; i < TM_MAX_CANVASES; i++) {
+        if (grids[i].in_use) continue;
+        grids[i].in_use = true;
+        grids[i].full_redraw = true; // target starts out undefined
+        grids[i].anim_count = 0;
+        grids[i].anim_warned = false;
+        return i;
+    }
+    TraceLog(LOG_WARNING, "TMGUI: no free canvas slot (TM_MAX_CANVASES = %d)", TM_MAX_CANVASES);
+    return -1;
+}
+
+// Layer 0 is the canvas itself
+static tm_canvas *layer_view(tm_canvas *c, int layer) {
+    if (layer <= 0) return c;
+    return &layer_views[c->layer_slots[(layer > c->layer_count ? c->layer_count : layer) - 1]];
+}
+
+tm_canvas tm_canvas_init(int grid_w, int grid_h, bool transparent) {
+    tm_canvas c = {0};
+    c.grid_w = grid_w;
+    c.grid_h = grid_h;
+    c.transparent = transparent;
+    c.slot = grid_alloc(grid_w, grid_h);
+
+    int slot = c.slot;
+    if (slot >= 0 && backend->canvas_init) backend->canvas_init(&c);
+    if (slot >= 0 && c.slot < 0) grids[slot].in_use = false; // refused by the backend
+    return c;
+}
+
+void tm_canvas_unload(tm_canvas *c) {
+    if (c->slot < 0) return;
+    for (int l = c->layer_count; l >= 0; l--) {
+        tm_canvas *layer = layer_view(c, l);
+        grids[layer->slot].in_use = false;
+        if (backend->canvas_unload) backend->canvas_unload(layer);
+        layer->slot = -1;
+    }
+    c->layer_count = 0;
+}
+
+void tm_canvas_invalidate(tm_canvas *c) {
+    if (c->slot < 0) return;
+    for (int l = 0; l <= c->layer_count; l++) grids[layer_view(c, l)->slot].full_redraw = true;
+}
+
+int tm_canvas_add_layer(tm_canvas *c, const char *name, bool transparent) {
+    if (c->slot < 0) return -1;
+    if (c->layer_count == TM_MAX_CANVAS_LAYERS) {
+        TraceLog(LOG_WARNING, "TMGUI: canvas already has TM_MAX_CANVAS_LAYERS (%d) layers", TM_MAX_CANVAS_LAYERS);
+        return -1;
+    }
+    int slot = grid_alloc(c->grid_w, c->grid_h);
+    if (slot < 0) return -1;
+
+    tm_canvas *layer = &layer_views[slot];
+    *layer = (tm_canvas){ .grid_w = c->grid_w, .grid_h = c->grid_h, .transparent = transparent, .slot = slot };
+    snprintf(layer_names[slot], sizeof(layer_names[slot]), "%s", name ? name : "");
+    if (backend->canvas_init) backend->canvas_init(layer);
+    if (layer->slot < 0) {
+        grids[slot].in_use = false;
+        return -1;
+    }
+
+    c->layer_slots[c->layer_count++] = slot;
+    return c->layer_count;
+}
+
+int tm_canvas_layer(const tm_canvas *c, const char *name) {
+    for (int l = 0; l < c->layer_count; l++)
+        if (strcmp(layer_names[c->layer_slots[l]], name) == 0) return l + 1;
+    return -1;
+}
+
+const tm_canvas *tm_canvas_get_layer(const tm_canvas *c, int layer) {
+    if (layer < 0 || layer > c->layer_count) return NULL;
+    return layer_view((tm_canvas *)c, layer);
+}
+
+// Shown cells of a grid slot as tm_cells. Palette cells are expanded into one shared buffer, valid until the next call.
+static const tm_cell *grid_shown(int slot) {
+#ifdef TM_PALETTE_CELLS
+    static tm_cell expanded[TM_MAX_CELLS];
+    for (int i = 0; i < TM_MAX_CELLS; i++) cell_expand(&grids[slot].shown[i], &expanded[i]);
+    return expanded;
+#else
+    return grids[slot].shown;
+#endif
+}
+
+const tm_cell *tm_canvas_cells(const tm_canvas *c) {
+    return (c->slot >= 0) ? grid_shown(c->slot) : NULL;
+}
+
+// Points the primitives at one of the active canvas' layers
+static void select_layer_cells(int layer) {
+    if (active_canvas) cells = grids[layer_view(active_canvas, layer)->slot].cells;
+}
+
+void tm_canvas_begin(tm_canvas *c) {
+    assets_poll(); // frame boundary, finished async loads are uploaded here
+    if (c->slot < 0) return;
+    active_canvas = c;
+    cells_w = c->grid_w;
+    cells_h = c->grid_h;
+
+    // Start every frame from cleared grids, the primitives only write cells
+    for (int l = 0; l <= c->layer_count; l++) {
+        const tm_canvas *layer = layer_view(c, l);
+        grid_cell clear = { 0 }; // no glyph, BLANK fg
+        clear.bg = ink_of(layer->transparent ? BLANK : BLACK).cell;
+        grid_cell *grid = grids[layer->slot].cells;
+        for (int i = 0; i < cells_w * cells_h; i++) grid[i] = clear;
+    }
+    select_layer_cells(draw_layer);
+    input_begin_frame(c->slot);
+    widgets_new_frame(c->slot);
+    layout_depth = 0;
+    layout_overflow = 0;
+    layout_overflow_warned = false;
+
+    cmd_count = 0;
+    cmd_text_used = 0;
+    for (int l = 0; l < TM_MAX_LAYERS; l++) frame_hashes[l] = HASH_SEED;
+}
+
+static inline bool color_equal(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Hands the dirty cells (ascending, shown already updated) to the backend: backgrounds as row spans of
+// equal color first, then the glyphs on top
+static void draw_dirty_cells(tm_canvas *c, const int *dirty, int dirty_count) {
+    cell_grid *g = &grids[c->slot];
+    stats.cells_drawn += dirty_count;
+    if (dirty_count == 0) return;
+    if (rec_file) record_cells(c, dirty, dirty_count);
+
+    // The backends see tm_cells (and may keep the pointers until end()), palette cells are expanded for them
+#ifdef TM_PALETTE_CELLS
+    static tm_cell expanded[TM_MAX_CELLS];
+    for (int i = 0; i < dirty_count; i++) cell_expand(&g->shown[dirty[i]], &expanded[i]);
+#define DIRTY_CELL(i) (&expanded[i])
+#else
+#define DIRTY_CELL(i) (&g->shown[dirty[i]])
+#endif
+
+    backend->begin(c);
+
+    for (int i = 0; i < dirty_count; ) {
+        int start = dirty[i], y = start / c->grid_w;
+        Color bg = DIRTY_CELL(i)->bg;
+        int j = i + 1;
+        while (j < dirty_count && dirty[j] == dirty[j - 1] + 1 && dirty[j] / c->grid_w == y &&
+               color_equal(DIRTY_CELL(j)->bg, bg)) j++;
+        backend->fill_span(start % c->grid_w, y, j - i, bg);
+        stats.bg_fills++;
+        i = j;
+    }
+
+    for (int i = 0; i < dirty_count; i++) {
+        const tm_cell *cell = DIRTY_CELL(i);
+        if (cell->page == TM_PAGE_NONE) continue;
+        backend->blit_glyph(dirty[i] % c->grid_w, dirty[i] / c->grid_w, cell);
+        stats.glyph_blits++;
+    }
+
+    backend->end(c);
+}
+
+// animate: resolve animated tiles and list the cells showing them, off for replays (their cells are resolved)
+static void flush_dirty_cells(tm_canvas *c, bool animate) {
+    cell_grid *g = &grids[c->slot];
+    int n = c->grid_w * c->grid_h;
+    static int dirty[TM_MAX_CELLS];
+    int dirty_count = 0;
+
+    g->anim_count = 0;
+    if (!animate || anim_count == 0) {
+        for (int i = 0; i < n; i++) {
+            if (g->full_redraw || memcmp(&g->cells[i], &g->shown[i], sizeof(grid_cell)) != 0) {
+                g->shown[i] = g->cells[i];
+                dirty[dirty_count++] = i;
+            }
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            grid_cell want = g->cells[i];
+            int a = anim_find(&want);
+            if (a >= 0) {
+                if (g->anim_count < TM_MAX_ANIM_CELLS) {
+                    g->anim_cells[g->anim_count] = i;
+                    g->anim_ids[g->anim_count++] = (unsigned char)a;
+                }
+                cell_set_glyph(&want, cell_page(&want), anim_now[a]);
+            }
+            if (g->full_redraw || memcmp(&want, &g->shown[i], sizeof(grid_cell)) != 0) {
+                g->shown[i] = want;
+                dirty[dirty_count++] = i;
+            }
+        }
+        if (g->anim_count == TM_MAX_ANIM_CELLS && !g->anim_warned) {
+            TraceLog(LOG_WARNING, "TMGUI: canvas %d has more than TM_MAX_ANIM_CELLS (%d) animated cells, the rest stay on their frame",
+                     c->slot, TM_MAX_ANIM_CELLS);
+            g->anim_warned = true;
+        }
+    }
+    g->full_redraw = false;
+    stats.anim_cells += g->anim_count;
+    draw_dirty_cells(c, dirty, dirty_count);
+}
+
+// The layout matched last frame, so only cells showing an animated tile can have changed. True if any did
+static bool flush_animated_cells(tm_canvas *c) {
+    cell_grid *g = &grids[c->slot];
+    static int dirty[TM_MAX_ANIM_CELLS];
+    int dirty_count = 0;
+
+    for (int k = 0; k < g->anim_count; k++) {
+        grid_cell *shown = &g->shown[g->anim_cells[k]];
+        unsigned short glyph = anim_now[g->anim_ids[k]];
+        if (cell_glyph(shown) == glyph) continue;
+        cell_set_glyph(shown, cell_page(shown), glyph);
+        dirty[dirty_count++] = g->anim_cells[k];
+    }
+    stats.anim_cells += g->anim_count;
+    draw_dirty_cells(c, dirty, dirty_count);
+    return dirty_count > 0;
+}
+
+// Last frames counters in the top right corner of the canvas, drawn as ordinary cells
+static void draw_stats_overlay(void) {
+    char line[32];
+    int x = cells_w - 18, y = 0;
+    Color fg = GREEN, bg = BLACK;
+
+    snprintf(line, sizeof(line), " FRAME   %6.2fms ", last_stats.frame_ms);   tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " WIDGETS   %6d ", last_stats.widgets);       tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " WRITTEN   %6d ", last_stats.cells_written); tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " DRAWN     %6d ", last_stats.cells_drawn);   tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " GLYPHS    %6d ", last_stats.glyph_blits);   tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " FILLS     %6d ", last_stats.bg_fills);      tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " TEXTURES  %6d ", last_stats.texture_switches); tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " CHARS     %6d ", last_stats.text_chars);    tm_draw_text(line, CELL(x, y++), fg, bg);
+    snprintf(line, sizeof(line), " UPSCALES  %6d ", last_stats.upscale_blits); tm_draw_text(line, CELL(x, y++), fg, bg);
+}
+
+void tm_canvas_end(tm_canvas *c) {
+    if (c->slot < 0) return;
+    if (layout_depth > 0) {
+        TraceLog(LOG_WARNING, "TMGUI: %d container(s) still open at tm_canvas_end, missing tm_box_end", layout_depth);
+        while (layout_depth > 0) tm_box_end();
+    }
+    bool was_deferred = deferred;
+    deferred = false; // replay and the overlay write cells directly
+    replay_draw_list();
+    if (show_stats) {
+        int keep = draw_layer;
+        tm_set_layer(c->layer_count); // topmost layer
+        draw_stats_overlay();
+        tm_set_layer(keep);
+    }
+    deferred = was_deferred;
+
+    // A layer with the same primitives as the frame its target already holds skips the diff and the
+    // backend draws, present just composites the cached targets. Without layers the per-layer hashes
+    // of the draw list all count for the one grid.
+    uint64_t whole = HASH_SEED;
+    for (int l = 0; l < TM_MAX_LAYERS; l++) whole = hash_bytes(whole, &frame_hashes[l], sizeof(uint64_t));
+
+    content_changed = false;
+    anim_update();
+    bool recording = record_frame_begin(c);
+    for (int l = 0; l <= c->layer_count; l++) {
+        tm_canvas *layer = layer_view(c, l);
+        cell_grid *g = &grids[layer->slot];
+        uint64_t hash = c->layer_count ? frame_hashes[l] : whole;
+        bool same = !g->full_redraw && hash == g->last_hash;
+        g->last_hash = hash;
+        if (same) {
+            if (g->anim_count > 0 && flush_animated_cells(layer)) content_changed = true;
+            continue;
+        }
+        flush_dirty_cells(layer, true);
+        content_changed = true;
+    }
+    if (recording) record_frame_end();
+    cells = NULL;
+    active_canvas = NULL;
+    owners = NULL;
+    if (backend->present) backend->present(c);
+
+    stats.frame_ms = GetFrameTime() * 1000.0f;
+    last_stats = stats;
+    stats = (tm_stats){ 0 };
+}
+
+// --- INPUT ---
+// One snapshot per frame, everything the widgets react to. A frame starts at the first tm_canvas_begin of a
+// canvas that was already begun since the last snapshot, so several canvases drawn in one frame share it
+// (and a click is seen by all of them) while a single canvas loop takes a new one every frame. Injected input
+// or a new script also starts one: it is for the next frame, whichever canvas begins it.
+static tm_input input_injected;
+static bool input_pending = false;
+static const tm_input *input_frames = NULL; // tm_input_script, caller owned
+static int input_frame_count = 0, input_frame_next = 0;
+static bool input_script_new = false;       // tm_input_script called, its first frame not taken yet
+static bool input_begun[TM_MAX_CANVASES];  // canvases begun on the current snapshot
+static int input_begun_count = 0;
+
+// What the devices say this frame
+static tm_input sample_input(void) {
+    tm_input in = { 0 };
+    in.frame_time = GetFrameTime();
+    in.mouse = device_mouse_grid();
+    for (int b = MOUSE_BUTTON_LEFT; b <= MOUSE_BUTTON_BACK; b++)
+        if (IsMouseButtonDown(b)) in.buttons |= 1 << b;
+    in.buttons |= term_buttons | term_clicked;
+    in.wheel = GetMouseWheelMove() + term_wheel;
+    term_clicked = 0;
+    term_wheel = 0.0f;
+    for (int k = KEY_SPACE; k <= KEY_KB_MENU && in.key_count < TM_INPUT_KEYS; k++) {
+        bool repeat = IsKeyPressedRepeat(k);
+        if (!IsKeyPressed(k) && !repeat) continue;
+        if (repeat) in.key_repeat |= 1u << in.key_count;
+        in.keys[in.key_count++] = k;
+    }
+    for (int t = 0; t < term_key_count && in.key_count < TM_INPUT_KEYS; t++) in.keys[in.key_count++] = term_keys[t];
+    term_key_count = 0;
+    return in;
+}
+
+static void input_begin_frame(int canvas_slot) {
+    bool fresh = input_pending || input_script_new;
+    if (input_begun_count > 0 && !input_begun[canvas_slot] && !fresh) { // same frame, another canvas
+        input_begun[canvas_slot] = true;
+        input_begun_count++;
+        return;
+    }
+    memset(input_begun, 0, sizeof(input_begun));
+    input_begun[canvas_slot] = true;
+    input_begun_count = 1;
+
+#ifdef TM_PALETTE_CELLS
+    palette_clock++;
+#endif
+    input_prev = input_now;
+    if (input_pending) {
+        input_now = input_injected;
+        input_pending = false;
+    } else if (input_frames && input_frame_next < input_frame_count) {
+        input_now = input_frames[input_frame_next++];
+        input_script_new = false;
+    } else {
+        input_now = sample_input();
+    }
+    if (input_now.key_count > TM_INPUT_KEYS) input_now.key_count = TM_INPUT_KEYS;
+    anim_clock += input_now.frame_time; // animated tiles follow the input, so scripted frames replay them exactly
+}
+
+void tm_input_inject(const tm_input *in) {
+    input_injected = *in;
+    input_pending = true;
+}
+
+void tm_input_script(const tm_input *frames, int count) {
+    input_frames = (count > 0) ? frames : NULL;
+    input_frame_count = (frames && count > 0) ? count : 0;
+    input_frame_next = 0;
+    input_script_new = input_frames != NULL;
+}
+
+int tm_input_script_left(void) {
+    return input_frame_count - input_frame_next;
+}
+
+const tm_input *tm_input_get(void) {
+    return &input_now;
+}
+
+static int input_key(int key) { // index in this frame's keys, -1 if it is not there
+    for (int i = 0; i < input_now.key_count; i++)
+        if (input_now.keys[i] == key) return i;
+    return -1;
+}
+
+bool tm_key_pressed(int key) {
+    int i = input_key(key);
+    return i >= 0 && !(input_now.key_repeat & (1u << i));
+}
+
+static bool key_step(int key) { return input_key(key) >= 0; } // pressed or repeated, for moving selections
+
+bool tm_mouse_pressed(int button) {
+    return (input_now.buttons & ~input_prev.buttons) & (1 << button);
+}
+
+bool tm_mouse_released(int button) {
+    return (input_prev.buttons & ~input_now.buttons) & (1 << button);
+}
+
+// --- RECORDING ---
+// Stream: "TMRC", version, then records. Numbers are LEB128 varints (zigzag for signed ones).
+//   header  grid_w grid_h cell_w cell_h, layer count, a transparent byte per layer (base first)
+//   'A'     asset: kind (0 sheet, 1 font), slot, path. Written before the first frame that may use it
+//   'F'     frame: frame time in us, input, then per flushed layer: index, run count, runs; 0xFF ends it
+//           a run is cells skipped since the last one, its length, then the cells. A cell is a flags byte
+//           saying which fields differ from the previous cell (REC_*) and those fields, REC_REPEAT adds a
+//           count of copies. Input is a mask of what changed since the last frame (REC_IN_*) and those values,
+//           keys as key << 1 | repeat.
+//   'E'     end
+
+#define REC_VERSION 2
+enum { REC_GLYPH = 1, REC_PAGE = 2, REC_FG = 4, REC_BG = 8, REC_REPEAT = 0x80 };
+enum { REC_IN_MOUSE = 1, REC_IN_BUTTONS = 2, REC_IN_WHEEL = 4, REC_IN_KEYS = 8 };
+
+static int rec_slots[TM_MAX_CANVAS_LAYERS + 1]; // grid slots of the recorded canvas and its layers
+static int rec_layers = 0;
+static int rec_fonts = 0, rec_atlases = 0;      // assets already in the stream
+static int rec_mouse_x, rec_mouse_y;             // last written, 1/16 cells
+static tm_input rec_last;
+
+static void put_varint(FILE *f, unsigned int v) {
+    for (; v >= 0x80; v >>= 7) fputc((int)(v & 0x7F) | 0x80, f);
+    fputc((int)v, f);
+}
+static void put_signed(FILE *f, int v) { put_varint(f, ((unsigned int)v << 1) ^ (unsigned int)(v >> 31)); }
+static void put_color(FILE *f, Color c) { fputc(c.r, f); fputc(c.g, f); fputc(c.b, f); fputc(c.a, f); }
+
+static unsigned int get_varint(FILE *f) {
+    unsigned int v = 0;
+    for (int shift = 0, b; shift < 35 && (b = fgetc(f)) != EOF; shift += 7) {
+        v |= (unsigned int)(b & 0x7F) << shift;
+        if (!(b & 0x80)) break;
+    }
+    return v;
+}
+static int get_signed(FILE *f) { unsigned int v = get_varint(f); return (int)(v >> 1) ^ -(int)(v & 1); }
+static Color get_color(FILE *f) {
+    Color c;
+    c.r = (unsigned char)fgetc(f); c.g = (unsigned char)fgetc(f); c.b = (unsigned char)fgetc(f); c.a = (unsigned char)fgetc(f);
+    return c;
+}
+
+static void record_assets(void) {
+    for (; rec_atlases < atlas_count; rec_atlases++) {
+        fputc('A', rec_file); fputc(0, rec_file); fputc(rec_atlases, rec_file);
+        put_varint(rec_file, (unsigned int)strlen(atlases[rec_atlases].path));
+        fputs(atlases[rec_atlases].path, rec_file);
+    }
+    for (; rec_fonts < font_count; rec_fonts++) {
+        if (fonts[rec_fonts].path[0] == '\0')
+            TraceLog(LOG_WARNING, "TMGUI: font slot %d has no path, a replay will not have its glyphs", rec_fonts);
+        fputc('A', rec_file); fputc(1, rec_file); fputc(rec_fonts, rec_file);
+        put_varint(rec_file, (unsigned int)strlen(fonts[rec_fonts].path));
+        fputs(fonts[rec_fonts].path, rec_file);
+    }
+}
+
+static bool record_frame_begin(const tm_canvas *c) {
+    if (!rec_file || c->slot != rec_slots[0]) return false;
+    record_assets();
+    tm_input *in = &input_now;
+    int mx = (int)floorf(in->mouse.x * 16), my = (int)floorf(in->mouse.y * 16);
+    bool keys = in->key_count > 0 || rec_last.key_count > 0;
+    int mask = (mx != rec_mouse_x || my != rec_mouse_y ? REC_IN_MOUSE : 0) |
+               (in->buttons != rec_last.buttons ? REC_IN_BUTTONS : 0) |
+               (in->wheel != rec_last.wheel ? REC_IN_WHEEL : 0) | (keys ? REC_IN_KEYS : 0);
+
+    fputc('F', rec_file);
+    put_varint(rec_file, (unsigned int)(in->frame_time * 1e6f));
+    fputc(mask, rec_file);
+    if (mask & REC_IN_MOUSE) { put_signed(rec_file, mx - rec_mouse_x); put_signed(rec_file, my - rec_mouse_y); }
+    if (mask & REC_IN_BUTTONS) fputc(in->buttons, rec_file);
+    if (mask & REC_IN_WHEEL) put_signed(rec_file, (int)(in->wheel * 16));
+    if (mask & REC_IN_KEYS) {
+        fputc(in->key_count, rec_file);
+        for (int k = 0; k < in->key_count; k++) // low bit: auto repeat
+            put_varint(rec_file, (unsigned int)in->keys[k] << 1 | ((in->key_repeat >> k) & 1));
+    }
+    rec_mouse_x = mx;
+    rec_mouse_y = my;
+    rec_last = *in;
+    return true;
+}
+
+static void record_frame_end(void) {
+    fputc(0xFF, rec_file);
+    fflush(rec_file); // a crashing session still leaves every finished frame behind
+}
+
+// Called by flush_dirty_cells with the cells it is about to hand the backend, in index order
+static void record_cells(const tm_canvas *c, const int *dirty, int count) {
+    int layer = -1;
+    for (int l = 0; l < rec_layers; l++)
+        if (rec_slots[l] == c->slot) layer = l;
+    if (layer < 0) return;
+
+    int runs = 1;
+    for (int i = 1; i < count; i++) runs += (dirty[i] != dirty[i - 1] + 1);
+    fputc(layer, rec_file);
+    put_varint(rec_file, (unsigned int)runs);
+
+    const grid_cell *shown = grids[c->slot].shown;
+    tm_cell last = { 0 };
+    int end = 0; // of the last run
+    for (int i = 0; i < count; ) {
+        int j = i + 1;
+        while (j < count && dirty[j] == dirty[j - 1] + 1) j++;
+        put_varint(rec_file, (unsigned int)(dirty[i] - end));
+        put_varint(rec_file, (unsigned int)(j - i));
+        end = dirty[j - 1] + 1;
+
+        for (int k = i; k < j; ) {
+            tm_cell cell;
+            cell_expand(&shown[dirty[k]], &cell);
+            int repeat = 0;
+            while (k + 1 + repeat < j && memcmp(&shown[dirty[k + 1 + repeat]], &shown[dirty[k]], sizeof(grid_cell)) == 0) repeat++;
+            int flags = (cell.glyph != last.glyph ? REC_GLYPH : 0) | (cell.page != last.page ? REC_PAGE : 0) |
+                        (!color_equal(cell.fg, last.fg) ? REC_FG : 0) | (!color_equal(cell.bg, last.bg) ? REC_BG : 0) |
+                        (repeat ? REC_REPEAT : 0);
+            fputc(flags, rec_file);
+            if (flags & REC_GLYPH) put_varint(rec_file, cell.glyph);
+            if (flags & REC_PAGE) fputc(cell.page, rec_file);
+            if (flags & REC_FG) put_color(rec_file, cell.fg);
+            if (flags & REC_BG) put_color(rec_file, cell.bg);
+            if (repeat) put_varint(rec_file, (unsigned int)repeat);
+            last = cell;
+            k += 1 + repeat;
+        }
+        i = j;
+    }
+}
+
+bool tm_record_start(const tm_canvas *c, const char *path) {
+    tm_record_stop();
+    if (c->slot < 0) return false;
+    rec_file = fopen(path, "wb");
+    if (!rec_file) {
+        TraceLog(LOG_WARNING, "TMGUI: could not open %s for recording", path);
+        return false;
+    }
+    rec_layers = c->layer_count + 1;
+    fputs("TMRC", rec_file);
+    fputc(REC_VERSION, rec_file);
+    put_varint(rec_file, (unsigned int)c->grid_w); put_varint(rec_file, (unsigned int)c->grid_h);
+    put_varint(rec_file, (unsigned int)cell_w); put_varint(rec_file, (unsigned int)cell_h);
+    fputc(rec_layers, rec_file);
+    for (int l = 0; l < rec_layers; l++) {
+        const tm_canvas *layer = tm_canvas_get_layer(c, l);
+        rec_slots[l] = layer->slot;
+        fputc(layer->transparent, rec_file);
+        grids[layer->slot].full_redraw = true; // the first frame carries every cell
+    }
+    rec_fonts = rec_atlases = 0;
+    rec_mouse_x = rec_mouse_y = 0;
+    rec_last = (tm_input){ 0 };
+    return true;
+}
+
+void tm_record_stop(void) {
+    if (!rec_file) return;
+    fputc('E', rec_file);
+    fclose(rec_file);
+    rec_file = NULL;
+}
+
+// - Player
+static FILE *play_file = NULL;
+static int play_layers = 0;
+static int play_mouse_x, play_mouse_y;
+static tm_input play_last;
+static unsigned char play_pages[PAGE_COUNT]; // recorded page -> the page its asset loaded into here
+
+// Checks the magic and reads the header up to the layer count, the transparent bytes are left to the caller
+static FILE *open_recording(const char *path, int size[4], int *layers) {
+    FILE *f = fopen(path, "rb");
+    char magic[4] = { 0 };
+    if (!f || fread(magic, 1, 4, f) != 4 || memcmp(magic, "TMRC", 4) != 0 || fgetc(f) != REC_VERSION) {
+        TraceLog(LOG_WARNING, "TMGUI: %s is not a TMGUI recording (version %d)", path, REC_VERSION);
+        if (f) fclose(f);
+        return NULL;
+    }
+    for (int i = 0; i < 4; i++) size[i] = (int)get_varint(f); // grid w, h, cell w, h
+    *layers = fgetc(f);
+    return f;
+}
+
+bool tm_replay_open(const char *path, tm_canvas *c) {
+    tm_replay_close();
+    int size[4];
+    play_file = open_recording(path, size, &play_layers);
+    if (!play_file) return false;
+    int w = size[0], h = size[1];
+    if (size[2] != cell_w || size[3] != cell_h)
+        TraceLog(LOG_WARNING, "TMGUI: %s was recorded with %dx%d cells, not %dx%d", path, size[2], size[3], cell_w, cell_h);
+    *c = tm_canvas_init(w, h, fgetc(play_file) == 1);
+    for (int l = 1; l < play_layers; l++) tm_canvas_add_layer(c, "replay", fgetc(play_file) == 1);
+    if (c->slot < 0 || c->layer_count != play_layers - 1) {
+        tm_replay_close();
+        return false;
+    }
+    for (int l = 0; l < play_layers; l++) {
+        cell_grid *g = &grids[tm_canvas_get_layer(c, l)->slot];
+        grid_cell clear = { 0 };
+        clear.bg = ink_of(tm_canvas_get_layer(c, l)->transparent ? BLANK : BLACK).cell;
+        for (int i = 0; i < w * h; i++) g->cells[i] = clear;
+    }
+    play_mouse_x = play_mouse_y = 0;
+    play_last = (tm_input){ 0 };
+    for (int p = 0; p < PAGE_COUNT; p++) play_pages[p] = (unsigned char)p;
+    return true;
+}
+
+static void replay_asset(void) {
+    int kind = fgetc(play_file), slot = fgetc(play_file);
+    char path[256];
+    unsigned int len = get_varint(play_file);
+    if (len >= sizeof(path)) return; // corrupt, tm_record_start paths fit: the next tag read ends the replay
+    if (fread(path, 1, len, play_file) != len) return;
+    path[len] = '\0';
+    if (len == 0 || (kind != 0 && kind != 1) || slot == EOF) return;
+    int got = (kind == 0) ? tm_load_atlas(path).slot : -1;
+    if (kind == 1) {
+        Font font = tm_load_font(path);
+        for (int i = 0; i < font_count; i++)
+            if (fonts[i].glyphs == font.glyphs) got = i;
+    }
+    // Slots are handed out in load order, which the replaying program need not share: the cells follow the asset
+    int base = (kind == 0) ? TM_PAGE_ATLAS : TM_PAGE_FONT, max = (kind == 0) ? TM_MAX_ATLASES : TM_MAX_FONTS;
+    if (slot >= max) return;
+    if (got >= 0) play_pages[base + slot] = (unsigned char)(base + got);
+    else TraceLog(LOG_WARNING, "TMGUI: replay could not load %s, its cells will show other glyphs", path);
+}
+
+// One frame's input over the last one, mouse_xy is the running position in 1/16 cells
+static void replay_input(FILE *f, tm_input *in, int mouse_xy[2]) {
+    in->frame_time = (float)get_varint(f) / 1e6f;
+    int mask = fgetc(f);
+    if (mask & REC_IN_MOUSE) { mouse_xy[0] += get_signed(f); mouse_xy[1] += get_signed(f); }
+    in->mouse = (Vector2){ mouse_xy[0] / 16.0f, mouse_xy[1] / 16.0f };
+    if (mask & REC_IN_BUTTONS) in->buttons = (unsigned char)fgetc(f);
+    if (mask & REC_IN_WHEEL) in->wheel = get_signed(f) / 16.0f;
+    if (mask & REC_IN_KEYS) {
+        in->key_count = fgetc(f);
+        in->key_repeat = 0;
+        for (int k = 0; k < in->key_count; k++) {
+            unsigned int key = get_varint(f);
+            if (k >= TM_INPUT_KEYS) continue;
+            in->keys[k] = (int)(key >> 1);
+            in->key_repeat |= (key & 1) << k;
+        }
+        if (in->key_count > TM_INPUT_KEYS) in->key_count = TM_INPUT_KEYS;
+    }
+}
+
+// grid NULL just skips the layer's cells. Pages go through play_pages.
+static void replay_layer(FILE *f, grid_cell *grid, int n) {
+    int runs = (int)get_varint(f), pos = 0;
+    tm_cell cell = { 0 };
+    for (int r = 0; r < runs; r++) {
+        pos += (int)get_varint(f);
+        int len = (int)get_varint(f);
+        while (len > 0) {
+            int flags = fgetc(f);
+            if (flags == EOF) return;
+            if (flags & REC_GLYPH) cell.glyph = (unsigned short)get_varint(f);
+            if (flags & REC_PAGE) cell.page = (unsigned char)fgetc(f);
+            if (flags & REC_FG) cell.fg = get_color(f);
+            if (flags & REC_BG) cell.bg = get_color(f);
+            int copies = 1 + ((flags & REC_REPEAT) ? (int)get_varint(f) : 0);
+            grid_cell stored = { 0 };
+            if (cell.page < PAGE_COUNT) cell_set_glyph(&stored, play_pages[cell.page], cell.glyph);
+            else cell_set_glyph(&stored, TM_PAGE_NONE, 0); // corrupt page: blank rather than another page's glyph
+            stored.fg = ink_of(cell.fg).cell;
+            stored.bg = ink_of(cell.bg).cell;
+            for (; copies > 0 && len > 0; copies--, len--, pos++)
+                if (grid && pos < n) grid[pos] = stored;
+        }
+    }
+}
+
+bool tm_replay_frame(tm_canvas *c, tm_input *input) {
+    if (!play_file || c->slot < 0) return false;
+    int tag;
+    while ((tag = fgetc(play_file)) == 'A') replay_asset();
+    if (tag != 'F') return false;
+
+    int mouse_xy[2] = { play_mouse_x, play_mouse_y };
+    replay_input(play_file, &play_last, mouse_xy);
+    play_mouse_x = mouse_xy[0];
+    play_mouse_y = mouse_xy[1];
+    if (input) *input = play_last;
+
+    int layer;
+    while ((layer = fgetc(play_file)) != 0xFF && layer != EOF) {
+        const tm_canvas *view = tm_canvas_get_layer(c, layer);
+        replay_layer(play_file, view ? grids[view->slot].cells : NULL, c->grid_w * c->grid_h);
+    }
+
+    // Same tail as tm_canvas_end, minus the layout: diff, backend, present
+    assets_poll();
+    for (int l = 0; l <= c->layer_count; l++) {
+        tm_canvas *view = layer_view(c, l);
+        grids[view->slot].last_hash = 0; // a live frame after this has to diff
+        flush_dirty_cells(view, false);
+    }
+    if (backend->present) backend->present(c);
+    last_stats = stats;
+    stats = (tm_stats){ 0 };
+    return layer == 0xFF;
+}
+
+void tm_replay_close(void) {
+    if (play_file) fclose(play_file);
+    play_file = NULL;
+}
+
+// Input only: assets and cells are skipped, no canvas or backend involved
+int tm_replay_inputs(const char *path, tm_input *out, int max) {
+    int size[4], layers;
+    FILE *f = open_recording(path, size, &layers);
+    if (!f) return 0;
+    for (int l = 0; l < layers; l++) fgetc(f);
+
+    tm_input in = { 0 };
+    int mouse_xy[2] = { 0, 0 }, count = 0, tag;
+    while (count < max && (tag = fgetc(f)) != EOF && tag != 'E') {
+        if (tag == 'A') {
+            fgetc(f); fgetc(f);
+            fseek(f, (long)get_varint(f), SEEK_CUR);
+            continue;
+        }
+        if (tag != 'F') break;
+        replay_input(f, &in, mouse_xy);
+        out[count++] = in;
+        int layer;
+        while ((layer = fgetc(f)) != 0xFF && layer != EOF) replay_layer(f, NULL, 0);
+    }
+    fclose(f);
+    return count;
+}
+
+// --- Frame pacing ---
+void tm_request_frame(void) {
+    frame_requested = true;
+}
+
+static bool input_activity(void) {
+    if (input_pending || tm_input_script_left() > 0) return true; // injected input, the devices may be idle
+    Vector2 d = GetMouseDelta();
+    if (d.x != 0.0f || d.y != 0.0f) return true;
+    Vector2 wheel = GetMouseWheelMoveV();
+    if (wheel.x != 0.0f || wheel.y != 0.0f) return true;
+    for (int b = MOUSE_BUTTON_LEFT; b <= MOUSE_BUTTON_BACK; b++)
+        if (IsMouseButtonPressed(b) || IsMouseButtonReleased(b)) return true;
+    // Not GetKeyPressed(), that would eat the key queue before the widgets see it
+    for (int k = KEY_SPACE; k <= KEY_KB_MENU; k++)
+        if (IsKeyPressed(k) || IsKeyReleased(k)) return true;
+    return false;
+}
+
+// Also true the frame after new content, so hover states and the like settle before going idle
+static bool anim_on_screen(void) {
+    for (int i = 0; i < TM_MAX_CANVASES; i++)
+        if (grids[i].in_use && grids[i].anim_count > 0) return true;
+    return false;
+}
+
+bool tm_frame_needed(void) {
+    bool needed = content_changed || frame_requested || asset_jobs_active > 0 || IsWindowResized() || input_activity() ||
+                  anim_on_screen();
+    frame_requested = false;
+    return needed;
+}
+
+// --- Stats ---
+const tm_stats *tm_get_stats(void) {
+    return &last_stats;
+}
+
+void tm_show_stats(bool show) {
+    show_stats = show;
+}
+
+bool tm_stats_shown(void) {
+    return show_stats;
+}
+
+
+//---------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------
+// --- BACKENDS -------------------------------------------------------------------------------------------
+
+void tm_set_backend(const tm_backend *b) { // every canvas has to re-render through the new backend
+    backend = b ? b : &TM_BACKEND_RAYLIB;
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
+}
+
+const tm_backend *tm_get_backend(void) {
+    return backend;
+}
+
+// --- Raylib backend ---
+// Spans go out as raw rlgl quads in one untextured pass, glyphs are bucketed per page texture and submitted
+// in end(). raylib only breaks a batch on texture/blend changes, so a frame costs a handful of draw calls
+// however many cells moved.
+
+typedef struct { int x, y; const tm_cell *cell; } rl_glyph;
+
+static rl_glyph rl_glyphs[TM_MAX_CELLS];
+static int rl_glyph_count = 0;
+static bool rl_drawing = false; // false for headless canvases, which have no target
+
+static inline void batch_quad(Rectangle dest, float u0, float v0, float u1, float v1, Color tint) {
+    rlCheckRenderBatchLimit(4);
+    rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+    rlTexCoord2f(u0, v0); rlVertex2f(dest.x, dest.y);
+    rlTexCoord2f(u0, v1); rlVertex2f(dest.x, dest.y + dest.height);
+    rlTexCoord2f(u1, v1); rlVertex2f(dest.x + dest.width, dest.y + dest.height);
+    rlTexCoord2f(u1, v0); rlVertex2f(dest.x + dest.width, dest.y);
+}
+
+static inline void batch_textured(Texture2D tex, Rectangle src, Rectangle dest, Color tint) {
+    batch_quad(dest, src.x / tex.width, src.y / tex.height,
+               (src.x + src.width) / tex.width, (src.y + src.height) / tex.height, tint);
+}
+
+// Emits one cells glyph quad (no background), from its pages range of the shared texture
+static inline void batch_cell_glyph(int x, int y, const tm_cell *cell) {
+    const glyph_page *page = &pages[cell->page];
+    if (page->image.data == NULL || cell->glyph >= page->count) return;
+    int g = shared_base[cell->page] + cell->glyph;
+    Rectangle src = { (g % SHARED_COLS) * cell_w, (g / SHARED_COLS) * cell_h, cell_w, cell_h };
+    batch_textured(shared_texture, src, grect_to_pixelrect(CELL(x, y)), cell->fg);
+}
+
+static void rl_canvas_init(tm_canvas *c) {
+    if (!IsWindowReady()) return; // headless canvases keep cells only, see tm_soft_render
+    c->target = LoadRenderTexture(c->grid_w * cell_w, c->grid_h * cell_h);
+    SetTextureFilter(c->target.texture, TEXTURE_FILTER_POINT);
+}
+
+static void rl_canvas_unload(tm_canvas *c) {
+    if (c->target.id != 0) UnloadRenderTexture(c->target);
+    c->target = (RenderTexture2D){ 0 };
+}
+
+static void rl_begin(tm_canvas *c) {
+    rl_drawing = (c->target.id != 0);
+    rl_glyph_count = 0;
+    if (!rl_drawing) return;
+
+    shared_pack(); // pages loaded during layout
+    BeginTextureMode(c->target);
+    // Backgrounds replace the old cell pixels outright (alpha included), so a transparent cell really clears
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    rlSetTexture(rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    stats.texture_switches++;
+}
+
+static void rl_fill_span(int x, int y, int len, Color bg) {
+    if (rl_drawing) batch_quad(grect_to_pixelrect((grect){ x, y, len, 1 }), 0, 0, 1, 1, bg);
+}
+
+static void rl_blit_glyph(int x, int y, const tm_cell *cell) {
+    if (rl_drawing) rl_glyphs[rl_glyph_count++] = (rl_glyph){ x, y, cell };
+}
+
+static void rl_end(tm_canvas *c) {
+    (void)c;
+    if (!rl_drawing) return;
+    rlEnd();
+    rlSetTexture(0);
+    EndBlendMode();
+
+    // Glyphs, alpha blended over the new backgrounds. Every page is in the shared texture: one bind.
+    if (rl_glyph_count > 0 && shared_texture.id != 0) {
+        rlSetTexture(shared_texture.id);
+        rlBegin(RL_QUADS);
+        stats.texture_switches++;
+        for (int i = 0; i < rl_glyph_count; i++) batch_cell_glyph(rl_glyphs[i].x, rl_glyphs[i].y, rl_glyphs[i].cell);
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    EndTextureMode();
+    rl_drawing = false;
+}
+
+static void rl_present(tm_canvas *c) { // upscale the target to the window, pixel perfect and centered
+    if (c->target.id == 0) return;
+    int sw = GetScreenWidth(), sh = GetScreenHeight();
+    int sx = sw / (c->grid_w * cell_w), sy = sh / (c->grid_h * cell_h);
+    c->scale = (sx < sy ? sx : sy);
+    if (c->scale < 1) c->scale = 1;
+
+    int dw = c->grid_w * cell_w * c->scale;
+    int dh = c->grid_h * cell_h * c->scale;
+    c->offset_x = (sw - dw) / 2;
+    c->offset_y = (sh - dh) / 2;
+
+    tm_update_transform(c->scale, c->offset_x, c->offset_y);
+
+    // Layers composite bottom to top, alpha blended over each other
+    for (int l = 0; l <= c->layer_count; l++) {
+        const tm_canvas *layer = l ? &layer_views[c->layer_slots[l - 1]] : c;
+        if (layer->target.id == 0) continue;
+        stats.upscale_blits++;
+        DrawTexturePro(layer->target.texture,
+            (Rectangle){ 0, 0, c->grid_w * cell_w, -c->grid_h * cell_h },
+            (Rectangle){ c->offset_x, c->offset_y, dw, dh },
+            (Vector2){ 0, 0 }, 0, WHITE);
+    }
+}
+
+const tm_backend TM_BACKEND_RAYLIB = {
+    "raylib", rl_canvas_init, rl_canvas_unload, rl_begin, rl_fill_span, rl_blit_glyph, rl_end, rl_present
+};
+
+// --- Null backend ---
+// Renders nothing, only counts what it was asked to do. Lets the layout code be profiled without a GL context.
+
+static tm_null_counts null_counts;
+
+static void null_begin(tm_canvas *c) { (void)c; null_counts.frames++; }
+static void null_fill_span(int x, int y, int len, Color bg) { (void)x; (void)y; (void)bg; null_counts.spans++; null_counts.span_cells += len; }
+static void null_blit_glyph(int x, int y, const tm_cell *cell) { (void)x; (void)y; (void)cell; null_counts.glyphs++; }
+static void null_end(tm_canvas *c) { (void)c; }
+static void null_present(tm_canvas *c) { (void)c; null_counts.presents++; }
+
+const tm_backend TM_BACKEND_NULL = {
+    "null", NULL, NULL, null_begin, null_fill_span, null_blit_glyph, null_end, null_present
+};
+
+tm_null_counts tm_null_backend_counts(bool reset) {
+    tm_null_counts counts = null_counts;
+    if (reset) null_counts = (tm_null_counts){ 0 };
+    return counts;
+}
+
+// --- Terminal backend ---
+// Presents one canvas (layers composited) as text at the top left of an ANSI terminal, for running tools over
+// SSH. Spans and glyphs only mark their cells, present() composites those, compares them with what the terminal
+// already shows and writes the ones that differ. Cursor moves and color changes are only emitted when the next
+// cell needs them, so an unchanged frame writes nothing at all. Mouse reports (xterm SGR mode) feed the input snapshot.
+
+#include <stdarg.h>
+#ifndef _WIN32
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#endif
+
+typedef struct { unsigned int cp; Color fg, bg; } term_cell;
+
+static term_cell term_screen[TM_MAX_CELLS];   // what the terminal shows
+static unsigned char term_dirty[TM_MAX_CELLS]; // marked by the spans and glyphs since the last present
+static int term_dirty_count = 0;
+static int term_canvases = 0;                 // canvases / layers using the backend, the terminal is set up while > 0
+static int term_grid_w = 0;                   // of the canvas being flushed
+static bool term_truecolor = true;
+static int term_cx = -1, term_cy = -1;        // cursor, -1 = unknown
+static Color term_fg, term_bg;
+static bool term_colors_known = false;
+static long long term_bytes = 0;
+
+static char term_out[16 * 1024];
+static int term_out_used = 0;
+
+static void term_stdout(const char *bytes, int len, void *user) {
+    (void)user;
+    fwrite(bytes, 1, (size_t)len, stdout);
+    fflush(stdout);
+}
+static void (*term_write)(const char *, int, void *) = term_stdout;
+static void *term_write_user = NULL;
+
+static const unsigned short *term_atlas_map[TM_MAX_ATLASES];
+static int term_atlas_map_count[TM_MAX_ATLASES];
+static unsigned char term_font_cp[TM_MAX_FONTS][256]; // font page cell -> codepoint, rebuilt per frame from the lut
+static bool term_font_built[TM_MAX_FONTS];
+
+// Default sheet (atlas slot 0, T_jpetscii.png) cell -> Unicode: text, digits and the panel kit pieces. 0 = none.
+static const unsigned short term_jpetscii[144] = {
+    ' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O',
+    'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '[', ']', '{', '}', 0x00A3,
+    '"', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+    'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', 0x2660, 0x2663, 0x2666, 0x2665, 0,
+    '1', '2', '3', '4', '5', '6', '7', '8', '9', '0', '-', '=', '_', '+', ':', ';',
+    '!', '@', '#', '$', '%', '^', '&', '*', '(', ')', '<', '/', '>', ',', '.', '?',
+    0x250C, 0x252C, 0x2510, 0x250F, 0x2501, 0x2513, 0, 0x2584, 0, 0x256D, 0x2500, 0x256E, 0x256D, 0x2576, 0x256E, 0x2500,
+    0x251C, 0x253C, 0x2524, 0x2503, 0x25A1, 0x2503, 0, 0x25CF, 0x258C, 0x2502, 0x25CF, 0x2502, 0x2577, 0x25AA, 0x2575, 0x2502,
+    0x2514, 0x2534, 0x2518, 0x2517, 0x2501, 0x251B, 0, 0x2588, 0, 0x2570, 0x2500, 0x256F, 0x2570, 0x2576, 0x256F, 0x2577,
+};
+#define TERM_UNMAPPED 0x00B7 // middle dot, for sheet cells without a codepoint
+
+static void term_flush(void) {
+    if (term_out_used == 0) return;
+    term_write(term_out, term_out_used, term_write_user);
+    term_bytes += term_out_used;
+    term_out_used = 0;
+}
+
+static void term_put(const char *bytes, int len) {
+    if (term_out_used + len > (int)sizeof(term_out)) term_flush();
+    memcpy(term_out + term_out_used, bytes, (size_t)len);
+    term_out_used += len;
+}
+
+static void term_printf(const char *fmt, ...) {
+    char buf[64];
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    term_put(buf, len);
+}
+
+static void term_put_utf8(unsigned int cp) {
+    char u[4];
+    int n = 0;
+    if (cp < 0x80) u[n++] = (char)cp;
+    else if (cp < 0x800) { u[n++] = (char)(0xC0 | cp >> 6); u[n++] = (char)(0x80 | (cp & 0x3F)); }
+    else { u[n++] = (char)(0xE0 | cp >> 12); u[n++] = (char)(0x80 | (cp >> 6 & 0x3F)); u[n++] = (char)(0x80 | (cp & 0x3F)); }
+    term_put(u, n);
+}
+
+// SGR color parameter ("38;..." fg, "48;..." bg): 24-bit, or the nearest entry of the xterm 6x6x6 cube
+static int term_color(char *out, int size, int sgr, Color c) {
+    if (term_truecolor) return snprintf(out, size, "%d;2;%d;%d;%d", sgr, c.r, c.g, c.b);
+    #define CUBE(v) ((v) < 48 ? 0 : (v) < 115 ? 1 : ((v) - 35) / 40)
+    return snprintf(out, size, "%d;5;%d", sgr, 16 + 36 * CUBE(c.r) + 6 * CUBE(c.g) + CUBE(c.b));
+    #undef CUBE
+}
+
+static unsigned int term_codepoint(const tm_cell *cell) {
+    if (cell->page == TM_PAGE_NONE) return ' ';
+    if (cell->page >= TM_PAGE_FONT) {
+        int slot = cell->page - TM_PAGE_FONT;
+        if (!term_font_built[slot]) {
+            memset(term_font_cp[slot], 0, sizeof(term_font_cp[slot]));
+            for (int cp = 255; cp >= 33; cp--) term_font_cp[slot][fonts[slot].lut[cp]] = (unsigned char)cp; // lowest wins
+            term_font_built[slot] = true;
+        }
+        unsigned int cp = (cell->glyph < 256) ? term_font_cp[slot][cell->glyph] : 0;
+        return cp ? cp : ' ';
+    }
+    int slot = cell->page - TM_PAGE_ATLAS;
+    const unsigned short *map = term_atlas_map[slot];
+    int count = term_atlas_map_count[slot];
+    if (!map && slot == 0) { map = term_jpetscii; count = (int)(sizeof(term_jpetscii) / sizeof(term_jpetscii[0])); }
+    unsigned int cp = (map && cell->glyph < count) ? map[cell->glyph] : 0;
+    return cp ? cp : TERM_UNMAPPED;
+}
+
+// What the terminal should show at cell i: layers stack like the soft rasterizer's blend, a glyph replaces
+// the character below, a background without one only recolors it (opaque ones clear it). Alpha ends up on black.
+static term_cell term_compose(const tm_canvas *c, int i) {
+    term_cell out = { ' ', WHITE, BLACK };
+    for (int l = 0; l <= c->layer_count; l++) {
+        tm_cell cell;
+        cell_expand(&grids[l ? c->layer_slots[l - 1] : c->slot].shown[i], &cell);
+        out.bg = ColorAlphaBlend(out.bg, cell.bg, WHITE);
+        if (cell.page != TM_PAGE_NONE) {
+            out.cp = term_codepoint(&cell);
+            out.fg = ColorAlphaBlend(out.bg, cell.fg, WHITE);
+        } else if (cell.bg.a == 255) {
+            out.cp = ' ';
+        }
+    }
+    out.fg.a = out.bg.a = 255;
+    if (out.cp == ' ') out.fg = term_fg; // a blank does not care, keeps the current color
+    return out;
+}
+
+#ifndef _WIN32
+static struct termios term_saved;
+static bool term_raw = false;
+
+static void term_key(int key) { // once per sample, a held key repeats as more of the same bytes
+    if (key == 0 || term_key_count == TM_INPUT_KEYS) return;
+    for (int i = 0; i < term_key_count; i++)
+        if (term_keys[i] == key) return;
+    term_keys[term_key_count++] = key;
+}
+
+// A byte typed on its own. Raylib key codes are the unshifted ASCII ones, shifted symbols have none.
+static int term_ascii_key(unsigned char ch) {
+    if (ch == '\r' || ch == '\n') return KEY_ENTER;
+    if (ch == '\t') return KEY_TAB;
+    if (ch == 0x7F || ch == 0x08) return KEY_BACKSPACE;
+    if (ch >= 'a' && ch <= 'z') return ch - 'a' + KEY_A;
+    if ((ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9')) return ch;
+    if (ch && strchr(" ',-./;=[\\]`", ch)) return ch;
+    return 0;
+}
+
+// ESC [ n ~ and the ESC [ / ESC O letter forms, modifiers (ESC [ 1 ; 5 A) ignored
+static int term_csi_key(char final, int n) {
+    switch (final) {
+    case 'A': return KEY_UP;
+    case 'B': return KEY_DOWN;
+    case 'C': return KEY_RIGHT;
+    case 'D': return KEY_LEFT;
+    case 'H': return KEY_HOME;
+    case 'F': return KEY_END;
+    case 'Z': return KEY_TAB; // shift tab
+    case '~':
+        switch (n) {
+        case 1: case 7: return KEY_HOME;
+        case 4: case 8: return KEY_END;
+        case 2: return KEY_INSERT;
+        case 3: return KEY_DELETE;
+        case 5: return KEY_PAGE_UP;
+        case 6: return KEY_PAGE_DOWN;
+        }
+    }
+    return 0;
+}
+
+// Keys and SGR mouse reports: ESC [ < button ; x ; y (M press / motion, m release), 1-based cells
+static void term_poll_input(void) {
+    static char in[256];
+    static int in_used = 0;
+    static bool esc_waited = false; // a lone ESC sat through one poll: the escape key, not a sequence start
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    while (term_raw && in_used < (int)sizeof(in) && poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN)) {
+        ssize_t n = read(STDIN_FILENO, in + in_used, sizeof(in) - in_used);
+        if (n <= 0) break;
+        in_used += (int)n;
+    }
+    int i = 0;
+    while (i < in_used) {
+        if (in[i] != 0x1B) { term_key(term_ascii_key((unsigned char)in[i++])); continue; }
+        if (i + 1 == in_used) {
+            if (!esc_waited) { esc_waited = true; break; }
+            term_key(KEY_ESCAPE);
+            i++;
+            continue;
+        }
+        if (in[i + 1] != '[' && in[i + 1] != 'O') { term_key(KEY_ESCAPE); i++; continue; } // alt + key: both
+        if (i + 2 >= in_used) break; // maybe the start of a sequence, wait for the rest
+        if (in[i + 1] == 'O' || in[i + 2] != '<') {
+            int j = i + 2, n = 0;
+            bool first = true;
+            for (; j < in_used && ((in[j] >= '0' && in[j] <= '9') || in[j] == ';'); j++) {
+                if (in[j] == ';') first = false;
+                else if (first) n = n * 10 + (in[j] - '0');
+            }
+            if (j == in_used) break;
+            term_key(term_csi_key(in[j], n));
+            i = j + 1;
+            continue;
+        }
+        int b = 0, x = 0, y = 0, *field = &b, j = i + 3;
+        while (j < in_used && in[j] != 'M' && in[j] != 'm') {
+            if (in[j] == ';') field = (field == &b) ? &x : &y;
+            else *field = *field * 10 + (in[j] - '0');
+            j++;
+        }
+        if (j == in_used) break;
+        term_mouse = (Vector2){ x - 0.5f, y - 0.5f }; // cell centre, tm_mouse_grid is fractional cells
+        term_mouse_seen = true;
+        tm_request_frame();
+        if (b & 64) { // wheel, 64 up / 65 down
+            term_wheel += (b & 1) ? -1.0f : 1.0f;
+        } else if (!(b & 32) && (b & 3) != 3) { // a press or release, not motion. Buttons: left, middle, right
+            static const unsigned char bit[3] = { 1 << MOUSE_BUTTON_LEFT, 1 << MOUSE_BUTTON_MIDDLE, 1 << MOUSE_BUTTON_RIGHT };
+            if (in[j] == 'M') { term_buttons |= bit[b & 3]; term_clicked |= bit[b & 3]; }
+            else term_buttons &= (unsigned char)~bit[b & 3];
+        }
+        i = j + 1;
+    }
+    if (i == in_used) esc_waited = false;
+    memmove(in, in + i, (size_t)(in_used - i));
+    in_used -= i;
+    if (in_used == (int)sizeof(in)) in_used = 0; // garbage, drop it
+}
+#else
+static void term_poll_input(void) {}
+#endif
+
+static void term_restore(void) {
+    if (term_canvases == 0) return;
+    term_canvases = 0;
+    term_printf("\x1b[0m\x1b[?1003l\x1b[?1006l\x1b[?25h\x1b[?1049l");
+    term_flush();
+#ifndef _WIN32
+    if (term_raw) tcsetattr(STDIN_FILENO, TCSANOW, &term_saved);
+    term_raw = false;
+#endif
+}
+
+// One terminal, one screen cache: further canvases are refused, layers of the one shown are its own
+static void term_canvas_init(tm_canvas *c) {
+    bool layer = c >= layer_views && c < layer_views + TM_MAX_CANVASES;
+    if (term_canvases > 0 && !layer) {
+        TraceLog(LOG_ERROR, "TMGUI: the terminal backend shows one canvas, unload the other one first");
+        c->slot = -1;
+        return;
+    }
+    if (term_canvases++ > 0) return;
+    static bool registered = false;
+    if (!registered) atexit(term_restore); // a crashed tool should not leave the terminal in raw mode
+    registered = true;
+#ifndef _WIN32
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &term_saved) == 0) {
+        struct termios raw = term_saved;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        term_raw = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+    }
+#endif
+    // Alternate screen, hidden cursor, cleared, any-motion mouse reports in SGR encoding
+    term_printf("\x1b[?1049h\x1b[?25l\x1b[0m\x1b[2J\x1b[?1003h\x1b[?1006h");
+    term_flush();
+    for (int i = 0; i < TM_MAX_CELLS; i++) term_screen[i] = (term_cell){ 0 }; // matches nothing, all get written
+    term_cx = term_cy = -1;
+    term_colors_known = false;
+}
+
+static void term_canvas_unload(tm_canvas *c) {
+    (void)c;
+    if (term_canvases == 1) term_restore();
+    else if (term_canvases > 0) term_canvases--;
+}
+
+static void term_mark(int x, int y, int len) {
+    for (int i = y * term_grid_w + x; len > 0; len--, i++) {
+        if (!term_dirty[i]) term_dirty_count++;
+        term_dirty[i] = 1;
+    }
+}
+
+static void term_begin(tm_canvas *c) { term_grid_w = c->grid_w; }
+static void term_fill_span(int x, int y, int len, Color bg) { (void)bg; term_mark(x, y, len); }
+static void term_blit_glyph(int x, int y, const tm_cell *cell) { (void)cell; term_mark(x, y, 1); }
+static void term_end(tm_canvas *c) { (void)c; }
+
+static void term_present(tm_canvas *c) {
+    term_poll_input();
+    if (term_dirty_count == 0) return;
+    memset(term_font_built, 0, sizeof(term_font_built)); // fonts may have been (re)baked since
+
+    int n = c->grid_w * c->grid_h;
+    for (int i = 0; i < n && term_dirty_count > 0; i++) {
+        if (!term_dirty[i]) continue;
+        term_dirty[i] = 0;
+        term_dirty_count--;
+
+        term_cell want = term_compose(c, i);
+        term_cell *have = &term_screen[i];
+        if (want.cp == have->cp && color_equal(want.bg, have->bg) && (want.cp == ' ' || color_equal(want.fg, have->fg))) continue;
+
+        int x = i % c->grid_w, y = i / c->grid_w;
+        if (y != term_cy || x < term_cx) term_printf("\x1b[%d;%dH", y + 1, x + 1);
+        else if (x == term_cx + 1) term_printf("\x1b[C");
+        else if (x > term_cx) term_printf("\x1b[%dC", x - term_cx); // cursor forward over cells that stay
+
+        bool fg = !term_colors_known || !color_equal(want.fg, term_fg);
+        bool bg = !term_colors_known || !color_equal(want.bg, term_bg);
+        if (fg || bg) { // one SGR for both
+            char sgr[48];
+            int len = 0;
+            if (fg) len += term_color(sgr + len, (int)sizeof(sgr) - len, 38, want.fg);
+            if (fg && bg) sgr[len++] = ';';
+            if (bg) len += term_color(sgr + len, (int)sizeof(sgr) - len, 48, want.bg);
+            term_printf("\x1b[%.*sm", len, sgr);
+        }
+        term_fg = want.fg;
+        term_bg = want.bg;
+        term_colors_known = true;
+        term_put_utf8(want.cp);
+        *have = want;
+        term_cx = x + 1;
+        term_cy = y;
+        if (term_cx >= c->grid_w) term_cx = term_cy = -1; // pending wrap, position it explicitly next time
+    }
+    term_flush();
+}
+
+const tm_backend TM_BACKEND_TERM = {
+    "term", term_canvas_init, term_canvas_unload, term_begin, term_fill_span, term_blit_glyph, term_end, term_present
+};
+
+void tm_term_set_glyph_map(tm_atlas atlas, const unsigned short *codepoints, int count) {
+    if (atlas.slot >= TM_MAX_ATLASES) return;
+    term_atlas_map[atlas.slot] = codepoints;
+    term_atlas_map_count[atlas.slot] = codepoints ? count : 0;
+    for (int i = 0; i < TM_MAX_CELLS; i++) term_screen[i].cp = 0; // everything may read differently now
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
+}
+
+void tm_term_set_truecolor(bool enabled) {
+    term_truecolor = enabled;
+    term_colors_known = false;
+    for (int i = 0; i < TM_MAX_CELLS; i++) term_screen[i].cp = 0;
+    for (int i = 0; i < TM_MAX_CANVASES; i++) grids[i].full_redraw = true;
 }
 
+void tm_term_set_writer(void (*write)(const char *bytes, int len, void *user), void *user) {
+    term_flush();
+    term_write = write ? write : term_stdout;
+    term_write_user = write ? user : NULL;
+}
 
-// --- TRANSFORM HELPERS --------------------------------------------------------------------------
+bool tm_term_size(int *cols, int *rows) {
+#ifndef _WIN32
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) {
+        *cols = ws.ws_col;
+        *rows = ws.ws_row;
+        return true;
+    }
+#endif
+    (void)cols; (void)rows;
+    return false;
+}
 
-void tm_update_transform(int scale, int pos_x, int pos_y) {
-    canvas_scale = scale;
-    canvas_x = pos_x;
-    canvas_y = pos_y;
+long long tm_term_bytes_written(bool reset) {
+    long long bytes = term_bytes;
+    if (reset) term_bytes = 0;
+    return bytes;
 }
 
 
-// --- INIT ---------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------
+//---------------------------------------------------------------------------------------------------------
+// --- SOFTWARE RASTERIZER --------------------------------------------------------------------------------
+// Pure CPU path: rasterizes a canvas' cells into an RGBA8 buffer, no GL context needed.
+// Pages are converted once into cell-contiguous texels (cell_w * cell_h per glyph) so a cell blit reads
+// one linear run, and the common 8x8 / 8x16 cell sizes get fixed-size blits the compiler can unroll.
+// With TM_SOFT_1BPP a page with at most two distinct texels (nearly every sheet and pixel font) keeps one bit
+// per pixel instead, 8 bytes for an 8x8 glyph. Both texels are shaded once per cell and the bits select
+// between the two, same pixels as the RGBA page for 1/32 of the storage.
+
+#if TM_SOFT_1BPP && defined(__AVX2__)
+#include <immintrin.h>
+#define SOFT_AVX2
+#elif TM_SOFT_1BPP && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define SOFT_SSE2
+#endif
+
+typedef struct {
+    int offset;      // into soft_texels, -1 until built
+    int count;       // glyph cells on the page
+    int stride;      // soft_texels per glyph, a 1bpp glyph is packed into as few as its bytes need
+    bool mono;       // 1bpp: set bits are texel[1], clear ones texel[0]
+    Color texel[2];
+} soft_page;
+
+static Color soft_texels[TM_SOFT_TEXELS];
+static int soft_texels_used = 0;
+static soft_page soft_pages[PAGE_COUNT];
+static int soft_cell_w = 0, soft_cell_h = 0; // cell size the pages were built for
+
+// Same result as the GPU path: texel tinted by fg, alpha blended over the cell background
+static inline Color soft_shade(Color t, Color fg, Color bg) {
+    int a = t.a * fg.a / 255;
+    if (a == 0) return bg;
+    Color src = { t.r * fg.r / 255, t.g * fg.g / 255, t.b * fg.b / 255, 255 };
+    if (a == 255) return src;
+    return (Color){
+        (src.r * a + bg.r * (255 - a)) / 255,
+        (src.g * a + bg.g * (255 - a)) / 255,
+        (src.b * a + bg.b * (255 - a)) / 255,
+        a + bg.a * (255 - a) / 255
+    };
+}
 
-void tmgui_init(int cell_width, int cell_height) {
-    cell_w = cell_width;
-    cell_h = cell_height;
+#define SOFT_BLIT_FIXED(name, W, H) \
+static void name(Color *dst, int stride, const Color *tex, Color fg, Color bg) { \
+    for (int y = 0; y < (H); y++, dst += stride, tex += (W)) \
+        for (int x = 0; x < (W); x++) dst[x] = soft_shade(tex[x], fg, bg); \
+}
+SOFT_BLIT_FIXED(soft_blit_8x8, 8, 8)
+SOFT_BLIT_FIXED(soft_blit_8x16, 8, 16)
 
-    fallback_font = LoadFontEx("C:/Code/tmgui/fonts/BESCII.ttf", cell_h, NULL, 0);
-    SetTextureFilter(fallback_font.texture, TEXTURE_FILTER_POINT);
+static void soft_blit_any(Color *dst, int stride, const Color *tex, Color fg, Color bg) {
+    for (int y = 0; y < cell_h; y++, dst += stride, tex += cell_w)
+        for (int x = 0; x < cell_w; x++) dst[x] = soft_shade(tex[x], fg, bg);
+}
 
-    current_theme = THEME_GREEN;
-    current_theme.font = fallback_font;
+// 1bpp rows are (cell_w + 7) / 8 bytes, bit x of a byte is pixel x. soft_expand8 turns one byte into 8 pixels
+// with a mask-and-select: lane x = (bits & 1 << x) ? on : off.
+static inline void soft_expand8(Color *dst, unsigned int bits, Color on, Color off) {
+#if defined(SOFT_AVX2) || defined(SOFT_SSE2)
+    int32_t on_word, off_word;
+    memcpy(&on_word, &on, sizeof(Color));
+    memcpy(&off_word, &off, sizeof(Color));
+#endif
+#if defined(SOFT_AVX2)
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32((int)bits), lanes), lanes);
+    _mm256_storeu_si256((__m256i *)dst, _mm256_blendv_epi8(_mm256_set1_epi32(off_word), _mm256_set1_epi32(on_word), mask));
+#elif defined(SOFT_SSE2)
+    const __m128i lanes_lo = _mm_setr_epi32(1, 2, 4, 8), lanes_hi = _mm_setr_epi32(16, 32, 64, 128);
+    __m128i b = _mm_set1_epi32((int)bits), fg = _mm_set1_epi32(on_word), bg = _mm_set1_epi32(off_word);
+    __m128i lo = _mm_cmpeq_epi32(_mm_and_si128(b, lanes_lo), lanes_lo);
+    __m128i hi = _mm_cmpeq_epi32(_mm_and_si128(b, lanes_hi), lanes_hi);
+    _mm_storeu_si128((__m128i *)dst, _mm_or_si128(_mm_and_si128(lo, fg), _mm_andnot_si128(lo, bg)));
+    _mm_storeu_si128((__m128i *)(dst + 4), _mm_or_si128(_mm_and_si128(hi, fg), _mm_andnot_si128(hi, bg)));
+#else
+    for (int x = 0; x < 8; x++) dst[x] = ((bits >> x) & 1) ? on : off;
+#endif
+}
 
-    glyph_atlas = LoadTexture("C:/Code/tmgui/glyphs/T_jpetscii.png");
-    SetTextureFilter(glyph_atlas, TEXTURE_FILTER_POINT);
+#define SOFT_BLIT_BITS_FIXED(name, W, H) \
+static void name(Color *dst, int stride, const unsigned char *bits, Color on, Color off) { \
+    for (int y = 0; y < (H); y++, dst += stride) \
+        for (int x = 0; x < (W); x += 8) soft_expand8(dst + x, *bits++, on, off); \
+}
+SOFT_BLIT_BITS_FIXED(soft_blit_bits_8x8, 8, 8)
+SOFT_BLIT_BITS_FIXED(soft_blit_bits_8x16, 8, 16)
+
+static void soft_blit_bits_any(Color *dst, int stride, const unsigned char *bits, Color on, Color off) {
+    for (int y = 0; y < cell_h; y++, dst += stride) {
+        int x = 0;
+        for (; x + 8 <= cell_w; x += 8) soft_expand8(dst + x, *bits++, on, off);
+        if (x < cell_w) {
+            for (int i = 0; x + i < cell_w; i++) dst[x + i] = ((*bits >> i) & 1) ? on : off;
+            bits++;
+        }
+    }
 }
 
-void tmgui_shutdown(void) {
-    UnloadFont(current_font);
-    UnloadTexture(glyph_atlas);
+static Color *soft_page_alloc(soft_page *sp, int size) {
+    if (soft_texels_used + size > TM_SOFT_TEXELS) {
+        TraceLog(LOG_WARNING, "TMGUI: software page storage full (TM_SOFT_TEXELS = %d)", TM_SOFT_TEXELS);
+        return NULL;
+    }
+    sp->offset = soft_texels_used;
+    soft_texels_used += size;
+    return &soft_texels[sp->offset];
 }
 
-static Font get_active_font(void) {
-    if (current_font.texture.id != 0) return current_font;
-    if (current_theme.font.texture.id != 0) return current_theme.font;
-    return fallback_font;
+#if TM_SOFT_1BPP
+// Distinct texels on the page, stops counting at 3. The first two end up in sp->texel.
+static int soft_page_colors(soft_page *sp, const glyph_page *page) {
+    int n = 0;
+    for (int g = 0; g < page->count; g++) {
+        int gx = (g % page->cols) * cell_w, gy = (g / page->cols) * cell_h;
+        for (int y = 0; y < cell_h; y++) {
+            for (int x = 0; x < cell_w; x++) {
+                Color t = GetImageColor(page->image, gx + x, gy + y);
+                if (n > 0 && color_equal(t, sp->texel[0])) continue;
+                if (n > 1 && color_equal(t, sp->texel[1])) continue;
+                if (n == 2) return 3;
+                sp->texel[n++] = t;
+            }
+        }
+    }
+    if (n == 1) sp->texel[1] = sp->texel[0];
+    return n;
 }
 
+static void soft_build_page_bits(soft_page *sp, const glyph_page *page) {
+    int row_bytes = (cell_w + 7) / 8;
+    sp->stride = (row_bytes * cell_h + (int)sizeof(Color) - 1) / (int)sizeof(Color);
+    unsigned char *out = (unsigned char *)soft_page_alloc(sp, page->count * sp->stride);
+    if (!out) return;
+    sp->count = page->count;
+    sp->mono = true;
+    memset(out, 0, (size_t)sp->count * sp->stride * sizeof(Color));
+    for (int g = 0; g < sp->count; g++, out += sp->stride * sizeof(Color)) {
+        int gx = (g % page->cols) * cell_w, gy = (g / page->cols) * cell_h;
+        for (int y = 0; y < cell_h; y++)
+            for (int x = 0; x < cell_w; x++)
+                if (color_equal(GetImageColor(page->image, gx + x, gy + y), sp->texel[1])) out[y * row_bytes + x / 8] |= 1 << (x % 8);
+    }
+}
+#endif
 
-// --- LAYOUT SETTERS ---------------------------------------------------------------------------------------
+static void soft_build_page(soft_page *sp, const glyph_page *page) {
+    sp->mono = false;
+#if TM_SOFT_1BPP
+    if (soft_page_colors(sp, page) <= 2) {
+        soft_build_page_bits(sp, page);
+        return;
+    }
+#endif
+    sp->stride = cell_w * cell_h;
+    Color *out = soft_page_alloc(sp, page->count * sp->stride);
+    if (!out) return;
+    sp->count = page->count;
+    for (int g = 0; g < sp->count; g++) {
+        int gx = (g % page->cols) * cell_w, gy = (g / page->cols) * cell_h;
+        for (int y = 0; y < cell_h; y++)
+            for (int x = 0; x < cell_w; x++) *out++ = GetImageColor(page->image, gx + x, gy + y);
+    }
+}
 
-void tm_set_theme(const tm_theme *theme) {
-    if (theme) current_theme = *theme;
+static void soft_pages_reset(void) { // drops every built page
+    for (int p = 0; p < PAGE_COUNT; p++) soft_pages[p].offset = -1;
+    soft_texels_used = 0;
 }
 
-void tm_set_font(Font *font) {
-    if (font && font->texture.id != 0) {
-        current_font = *font;
-    } else {
-        current_font = current_theme.font;
+static const Color *soft_page_texels(int page) { // builds pages on first use
+    static unsigned int generation = 0;
+    if (soft_cell_w != cell_w || soft_cell_h != cell_h || generation != page_generation) {
+        soft_pages_reset();
+        soft_cell_w = cell_w;
+        soft_cell_h = cell_h;
+        generation = page_generation;
     }
+    soft_page *sp = &soft_pages[page];
+    if (sp->offset < 0 && pages[page].image.data != NULL) soft_build_page(sp, &pages[page]);
+    return (sp->offset < 0) ? NULL : &soft_texels[sp->offset];
 }
 
-void tm_set_spacing(int spacing) {
-    layout_spacing = spacing;
+// Texels of a cell's glyph on an already built page, NULL otherwise. Builds nothing, so the raster workers can use it.
+static inline const Color *soft_glyph(const tm_cell *cell) {
+    const soft_page *sp = &soft_pages[cell->page];
+    return (sp->offset < 0 || cell->glyph >= sp->count) ? NULL : &soft_texels[sp->offset + cell->glyph * sp->stride];
 }
 
-void tm_set_padding(int padding) {
-    layout_padding = padding;
+// Buffer the soft blits currently write to
+static Color *soft_fb = NULL;
+static int soft_stride = 0;
+static void (*soft_blit)(Color *, int, const Color *, Color, Color) = soft_blit_any;
+static void (*soft_blit_bits)(Color *, int, const unsigned char *, Color, Color) = soft_blit_bits_any;
+static unsigned char *soft_targets[TM_MAX_CANVASES]; // per canvas slot, for the soft backend
+
+static void soft_bind(const tm_canvas *c, unsigned char *rgba) {
+    soft_fb = (Color *)rgba;
+    soft_stride = c->grid_w * cell_w;
+    soft_blit = (cell_w == 8 && cell_h == 8)  ? soft_blit_8x8 :
+                (cell_w == 8 && cell_h == 16) ? soft_blit_8x16 : soft_blit_any;
+    soft_blit_bits = (cell_w == 8 && cell_h == 8)  ? soft_blit_bits_8x8 :
+                     (cell_w == 8 && cell_h == 16) ? soft_blit_bits_8x16 : soft_blit_bits_any;
 }
 
-void tm_align_horizontal(align_mode mode) {
-    h_align = mode;
+static void soft_fill_span(int x, int y, int len, Color bg) {
+    if (!soft_fb) return;
+    Color *dst = soft_fb + (y * cell_h) * soft_stride + x * cell_w;
+    for (int row = 0; row < cell_h; row++, dst += soft_stride)
+        for (int i = 0; i < len * cell_w; i++) dst[i] = bg;
 }
 
-void tm_align_vertical(align_mode mode) {
-    v_align = mode;
+static void soft_draw_glyph(int x, int y, const tm_cell *cell) {
+    const Color *tex = soft_glyph(cell);
+    if (!tex) return;
+    const soft_page *sp = &soft_pages[cell->page];
+    Color *dst = soft_fb + (y * cell_h) * soft_stride + x * cell_w;
+    if (sp->mono) soft_blit_bits(dst, soft_stride, (const unsigned char *)tex, soft_shade(sp->texel[1], cell->fg, cell->bg),
+                                 soft_shade(sp->texel[0], cell->fg, cell->bg));
+    else soft_blit(dst, soft_stride, tex, cell->fg, cell->bg);
 }
 
-// Returns a grect (CELL) for text starting point aligned inside rect
-grect tm_align_text_pos(grect container, int text_width_in_cells, int text_height_in_cells) {
-    int x = container.x; // padding now handled explicitly in caller
-    int y = container.y;
+static void soft_blit_glyph(int x, int y, const tm_cell *cell) {
+    if (soft_fb && soft_page_texels(cell->page)) soft_draw_glyph(x, y, cell);
+}
 
-    // Horizontal alignment
-    if (h_align == ALIGN_CENTER)
-        x = container.x + (container.w - text_width_in_cells) / 2;
-    else if (h_align == ALIGN_RIGHT)
-        x = container.x + container.w - text_width_in_cells;
+int tm_soft_buffer_size(const tm_canvas *c) {
+    return c->grid_w * cell_w * c->grid_h * cell_h * (int)sizeof(Color);
+}
 
-    // Vertical alignment
-    if (v_align == ALIGN_CENTER)
-        y = container.y + (container.h - text_height_in_cells) / 2;
-    else if (v_align == ALIGN_BOTTOM)
-        y = container.y + container.h - text_height_in_cells;
+// Layer cell alpha blended over what the layers below left in the buffer
+static void soft_blend_cell(int x, int y, const tm_cell *cell) {
+    const Color *tex = (cell->page != TM_PAGE_NONE) ? soft_glyph(cell) : NULL;
+    if (!tex && cell->bg.a == 0) return;
+
+    const soft_page *sp = &soft_pages[cell->page];
+    const unsigned char *bits = (const unsigned char *)tex;
+    Color on = { 0 }, off = { 0 };
+    if (tex && sp->mono) {
+        on = soft_shade(sp->texel[1], cell->fg, cell->bg);
+        off = soft_shade(sp->texel[0], cell->fg, cell->bg);
+    }
+    int row_bytes = (cell_w + 7) / 8;
+    Color *dst = soft_fb + (y * cell_h) * soft_stride + x * cell_w;
+    for (int row = 0; row < cell_h; row++, dst += soft_stride) {
+        for (int i = 0; i < cell_w; i++) {
+            Color src = !tex     ? cell->bg :
+                        sp->mono ? (((bits[row * row_bytes + i / 8] >> (i % 8)) & 1) ? on : off) :
+                                   soft_shade(tex[row * cell_w + i], cell->fg, cell->bg);
+            dst[i] = ColorAlphaBlend(dst[i], src, WHITE);
+        }
+    }
+}
 
-    return CELL(x, y); // Return as a CELL grect
+// Cell rows [y0, y1) of the canvas, base layer and then every layer over it. Bands touch disjoint pixels and
+// only read the cells and built pages, so they can run in any order on any thread.
+static void soft_render_band(const tm_canvas *c, int y0, int y1) {
+    tm_cell cell;
+    const grid_cell *grid = grids[c->slot].shown;
+    for (int y = y0; y < y1; y++) {
+        for (int x = 0; x < c->grid_w; x++) {
+            cell_expand(&grid[y * c->grid_w + x], &cell);
+            soft_fill_span(x, y, 1, cell.bg);
+            if (cell.page != TM_PAGE_NONE) soft_draw_glyph(x, y, &cell);
+        }
+    }
+    for (int l = 1; l <= c->layer_count; l++) {
+        const grid_cell *layer = grids[c->layer_slots[l - 1]].shown;
+        for (int y = y0; y < y1; y++) {
+            for (int x = 0; x < c->grid_w; x++) {
+                cell_expand(&layer[y * c->grid_w + x], &cell);
+                soft_blend_cell(x, y, &cell);
+            }
+        }
+    }
 }
 
-// --- Canvas ---
-tm_canvas tm_canvas_init(int grid_w, int grid_h, bool transparent) {
-    tm_canvas c = {0};
-    c.grid_w = grid_w;
-    c.grid_h = grid_h;
-    c.transparent = transparent;
-    c.target = LoadRenderTexture(grid_w * cell_w, grid_h * cell_h);
-    SetTextureFilter(c.target.texture, TEXTURE_FILTER_POINT);
-    return c;
+// --- Raster pool ---
+// TM_RASTER_THREADS persistent workers plus the calling thread. Each starts on an even share of the bands and
+// takes them front to back, one that runs dry steals the back half of whoever has the most left. Bands are
+// whole cell rows, so a lock per claim costs nothing next to the raster work. Started on first use.
+#define RASTER_MIN_CELLS 4096 // below this a canvas is rendered inline, waking the pool costs more
+
+typedef struct { int next, end; } band_queue; // bands [next, end) not claimed yet
+
+static band_queue raster_queues[TM_RASTER_THREADS + 1]; // one per worker, the last is the calling thread's
+static const tm_canvas *raster_canvas = NULL;          // being rendered
+
+#ifndef TM_NO_THREADS
+static sync_lock raster_lock = SYNC_LOCK_INIT;
+static sync_cond raster_wake = SYNC_COND_INIT, raster_done = SYNC_COND_INIT;
+static sync_thread raster_threads[TM_RASTER_THREADS + 1]; // + 1 keeps it an array with TM_RASTER_THREADS 0
+static int raster_started = 0;      // workers running
+static unsigned int raster_job = 0; // bumped per render, a worker waits for one it has not seen
+static int raster_busy = 0;         // workers still on the current job
+static bool raster_quit = false;
+#endif
+
+static bool raster_claim(int self, int *band) {
+#ifndef TM_NO_THREADS
+    lock(&raster_lock);
+#endif
+    band_queue *q = &raster_queues[self];
+    if (q->next >= q->end) {
+        band_queue *victim = NULL;
+        for (int i = 0; i <= TM_RASTER_THREADS; i++) {
+            band_queue *v = &raster_queues[i];
+            if (v->end - v->next > (victim ? victim->end - victim->next : 0)) victim = v;
+        }
+        if (victim) {
+            int take = (victim->end - victim->next + 1) / 2;
+            q->next = victim->end - take;
+            q->end = victim->end;
+            victim->end -= take;
+        }
+    }
+    bool got = q->next < q->end;
+    if (got) *band = q->next++;
+#ifndef TM_NO_THREADS
+    unlock(&raster_lock);
+#endif
+    return got;
 }
 
-void tm_canvas_begin(tm_canvas *c) {
-    BeginTextureMode(c->target);
-    ClearBackground(c->transparent ? BLANK : BLACK);
+static void raster_run(int self) {
+    int band;
+    while (raster_claim(self, &band)) {
+        int y0 = band * TM_RASTER_BAND;
+        int y1 = (y0 + TM_RASTER_BAND < raster_canvas->grid_h) ? y0 + TM_RASTER_BAND : raster_canvas->grid_h;
+        soft_render_band(raster_canvas, y0, y1);
+    }
 }
 
-void tm_canvas_end(tm_canvas *c) {
-    EndTextureMode();
-    int sw = GetScreenWidth(), sh = GetScreenHeight();
-    int sx = sw / (c->grid_w * cell_w), sy = sh / (c->grid_h * cell_h);
-    c->scale = (sx < sy ? sx : sy);
-    if (c->scale < 1) c->scale = 1;
+#ifndef TM_NO_THREADS
+static void raster_worker(void *arg) {
+    int self = (int)(intptr_t)arg;
+    unsigned int seen = 0;
+    lock(&raster_lock);
+    for (;;) {
+        while (!raster_quit && raster_job == seen) cond_wait(&raster_wake, &raster_lock);
+        if (raster_quit) break;
+        seen = raster_job;
+        unlock(&raster_lock);
+        raster_run(self);
+        lock(&raster_lock);
+        if (--raster_busy == 0) cond_wake(&raster_done);
+    }
+    unlock(&raster_lock);
+}
+#endif
+
+static void raster_stop(void) {
+#ifndef TM_NO_THREADS
+    if (raster_started == 0) return;
+    lock(&raster_lock);
+    raster_quit = true;
+    cond_wake(&raster_wake);
+    unlock(&raster_lock);
+    for (int i = 0; i < raster_started; i++) thread_join(&raster_threads[i]);
+    raster_started = 0;
+    raster_quit = false;
+#endif
+}
 
-    int dw = c->grid_w * cell_w * c->scale;
-    int dh = c->grid_h * cell_h * c->scale;
-    c->offset_x = (sw - dw) / 2;
-    c->offset_y = (sh - dh) / 2;
+// Spreads the bands over the pool and joins in, returns once every band is done
+static void raster_dispatch(const tm_canvas *c) {
+    int workers = 0;
+#ifndef TM_NO_THREADS
+    if (raster_started == 0) { // a thread that fails to start just leaves fewer workers
+        while (raster_started < TM_RASTER_THREADS) {
+            sync_thread *t = &raster_threads[raster_started];
+            t->fn = raster_worker;
+            t->arg = (void *)(intptr_t)raster_started;
+            if (!thread_start(t)) break;
+            raster_started++;
+        }
+    }
+    workers = raster_started;
+    lock(&raster_lock);
+#endif
+    raster_canvas = c;
+    int bands = (c->grid_h + TM_RASTER_BAND - 1) / TM_RASTER_BAND;
+    for (int i = 0; i <= TM_RASTER_THREADS; i++) raster_queues[i] = (band_queue){ 0, 0 };
+    int share = bands / (workers + 1), extra = bands % (workers + 1), next = 0;
+    for (int i = 0; i <= workers; i++) {
+        band_queue *q = &raster_queues[(i < workers) ? i : TM_RASTER_THREADS];
+        q->next = next;
+        q->end = next += share + (i < extra);
+    }
+#ifndef TM_NO_THREADS
+    raster_busy = workers;
+    raster_job++;
+    cond_wake(&raster_wake);
+    unlock(&raster_lock);
+#endif
+    raster_run(TM_RASTER_THREADS);
+#ifndef TM_NO_THREADS
+    lock(&raster_lock);
+    while (raster_busy > 0) cond_wait(&raster_done, &raster_lock);
+    unlock(&raster_lock);
+#endif
+}
 
-    tm_update_transform(c->scale, c->offset_x, c->offset_y);
+void tm_soft_render(const tm_canvas *c, unsigned char *rgba) {
+    if (c->slot < 0 || !rgba) return;
+    soft_bind(c, rgba);
+
+    // Pages are built here, on this thread, the bands only look them up
+    bool used[PAGE_COUNT] = { false };
+    int n = c->grid_w * c->grid_h;
+    for (int l = 0; l <= c->layer_count; l++) {
+        const grid_cell *grid = grids[l ? c->layer_slots[l - 1] : c->slot].shown;
+        for (int i = 0; i < n; i++) used[cell_page(&grid[i])] = true;
+    }
+    for (int p = TM_PAGE_ATLAS; p < PAGE_COUNT; p++) {
+        if (used[p]) soft_page_texels(p);
+    }
+
+    if (TM_RASTER_THREADS == 0 || n < RASTER_MIN_CELLS) soft_render_band(c, 0, c->grid_h);
+    else raster_dispatch(c);
+}
 
-    DrawTexturePro(c->target.texture,
-        (Rectangle){ 0, 0, c->grid_w * cell_w, -c->grid_h * cell_h },
-        (Rectangle){ c->offset_x, c->offset_y, dw, dh },
-        (Vector2){ 0, 0 }, 0, WHITE);
+bool tm_soft_export(const tm_canvas *c, unsigned char *rgba, const char *path) {
+    tm_soft_render(c, rgba);
+    Image img = { rgba, c->grid_w * cell_w, c->grid_h * cell_h, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    return ExportImage(img, path);
 }
 
+// --- Soft backend ---
+// Same blits, but fed the dirty cells by tm_canvas_end, so a retained RGBA buffer only touches what changed.
+
+void tm_soft_set_target(const tm_canvas *c, unsigned char *rgba) {
+    if (c->slot < 0) return;
+    soft_targets[c->slot] = rgba;
+    grids[c->slot].full_redraw = true; // new buffer holds nothing yet
+}
+
+static void soft_begin(tm_canvas *c) { soft_bind(c, soft_targets[c->slot]); }
+static void soft_end(tm_canvas *c) { (void)c; soft_fb = NULL; }
+
+const tm_backend TM_BACKEND_SOFT = {
+    "soft", NULL, NULL, soft_begin, soft_fill_span, soft_blit_glyph, soft_end, NULL
+};
+
 
 //---------------------------------------------------------------------------------------------------------
 //---------------------------------------------------------------------------------------------------------
 // --- DRAW PRIMITIVES ------------------------------------------------------------------------------------
 
-inline void tm_draw_fill_rect(grect area, Color color) {
-    Rectangle px = grect_to_pixelrect(area);
-    DrawRectangle(px.x, px.y, px.width, px.height, color);
+// Primitives write into the active canvas cells, tm_canvas_end renders whatever changed
+
+static inline grid_cell *cell_at(int x, int y) { // NULL when off-grid or outside a canvas
+    if (!cells || x < 0 || y < 0 || x >= cells_w || y >= cells_h) return NULL;
+    return &cells[y * cells_w + x];
 }
 
-inline void tm_draw_fill_cell(grect cell, Color color) {
-    // Convert cell grect to pixel-space Rectangle
-    Rectangle fill = grect_to_pixelrect((grect){ cell.x, cell.y, 1, 1 });
-    // Draw filled rectangle using raylib helper
-    DrawRectangleRec(fill, color);
+static inline void cell_fill(grid_cell *cell, ink color) {
+    if (color.rgba.a == 255) { // opaque fill covers whatever glyph was there
+        cell_set_glyph(cell, TM_PAGE_NONE, 0);
+        cell->fg = ink_of(BLANK).cell;
+        cell->bg = color.cell;
+    } else if (color.rgba.a > 0) {
+        cell->bg = ink_of(ColorAlphaBlend(cell_rgba(cell->bg), color.rgba, WHITE)).cell;
+    }
 }
 
-void tm_draw_glyph(grect cell, atlaspos glyph, Color fg, Color bg) {
-    Rectangle dest = (Rectangle){ cell.x * cell_w, cell.y * cell_h, cell_w, cell_h };
-    Rectangle src = (Rectangle){ glyph.x * cell_w, glyph.y * cell_h, cell_w, cell_h };
-    if (bg.a > 0) tm_draw_fill_cell(cell, bg);
-    DrawTexturePro(glyph_atlas, src, dest, (Vector2){0, 0}, 0, fg);
+static void fill_rect_cells(grect area, Color fill) {
+    if (!cells) return;
+    ink color = ink_of(fill);
+    int x0 = area.x < 0 ? 0 : area.x, x1 = area.x + area.w > cells_w ? cells_w : area.x + area.w;
+    int y0 = area.y < 0 ? 0 : area.y, y1 = area.y + area.h > cells_h ? cells_h : area.y + area.h;
+    if (x1 > x0 && y1 > y0) stats.cells_written += (x1 - x0) * (y1 - y0);
+    for (int y = y0; y < y1; y++)
+        for (int x = x0; x < x1; x++)
+            cell_fill(&cells[y * cells_w + x], color);
 }
 
-void tm_draw_text(const char *text, grect cell, Color fg, Color bg) {
-    Font font = get_active_font();
+static inline unsigned short atlas_index(unsigned char page, atlaspos glyph) {
+    const glyph_page *sheet = atlas_page(page - TM_PAGE_ATLAS);
+    return sheet->cols ? glyph.y * sheet->cols + glyph.x : 0;
+}
+
+static inline void cell_put_glyph(grid_cell *c, unsigned char page, unsigned short index, ink fg, ink bg) {
+    stats.cells_written++;
+    if (bg.rgba.a > 0) cell_fill(c, bg);
+    cell_set_glyph(c, page, index);
+    c->fg = fg.cell;
+}
+
+static void text_cells(const char *text, grect cell, unsigned char page, Color fg_color, Color bg_color) {
+    const unsigned short *lut = fonts[page - TM_PAGE_FONT].lut;
+    ink fg = ink_of(fg_color), bg = ink_of(bg_color);
 
     for (int i = 0; text[i]; i++) {
-        // Position of each character cell (offset horizontally)
-        grect char_cell = { cell.x + i, cell.y, 1, 1 }; // Ensure w and h are 1 for character cells
+        grid_cell *c = cell_at(cell.x + i, cell.y); // Each character takes one cell
+        if (!c) continue;
+        stats.cells_written++;
+        stats.text_chars++;
+        cell_fill(c, bg);
+        unsigned short index = lut[(unsigned char)text[i]];
+        if (index == 0) continue; // blank glyph, background only
+        cell_set_glyph(c, page, index);
+        c->fg = fg.cell;
+    }
+}
+
+// One panel row straight into the cells: left glyph, repeated middle glyph, right glyph. Clipped to the grid.
+static void panel_row(int x, int y, int w, unsigned char page, const unsigned short lmr[3], ink fg, ink bg) {
+    if (!cells || y < 0 || y >= cells_h) return;
+    int x0 = x < 0 ? 0 : x, x1 = x + w > cells_w ? cells_w : x + w;
+    grid_cell *row = &cells[y * cells_w];
+    for (int i = x0; i < x1; i++) {
+        unsigned short index = (i == x + w - 1) ? lmr[2] : (i == x) ? lmr[0] : lmr[1];
+        cell_put_glyph(&row[i], page, index, fg, bg);
+    }
+}
+
+// Every cell gets a glyph over the panel background, so no separate background fill is needed
+static void panel_cells(grect r, unsigned char page, const unsigned short kit[9], bool strip, Color fg_color, Color bg_color) {
+    ink fg = ink_of(fg_color), bg = ink_of(bg_color);
+    if (strip) {
+        panel_row(r.x, r.y, r.w, page, kit, fg, bg);
+        return;
+    }
+    // Top edge with corners, left/right edges around the fill, bottom edge with corners
+    panel_row(r.x, r.y, r.w, page, kit, fg, bg);
+    for (int j = 1; j < r.h - 1; j++)
+        panel_row(r.x, r.y + j, r.w, page, kit + 3, fg, bg);
+    panel_row(r.x, r.y + r.h - 1, r.w, page, kit + 6, fg, bg);
+}
+
+// Type, deferred flag and arguments of a primitive, into the hash of the layer it lands on
+static uint64_t *hash_prim(draw_cmd_type type, grect area, Color fg, Color bg) {
+    int layer = deferred ? draw_layer : 0;
+    if (active_canvas && active_canvas->layer_count)
+        layer = (draw_layer > active_canvas->layer_count) ? active_canvas->layer_count : draw_layer;
+    uint64_t *h = &frame_hashes[layer];
+    unsigned char head[2] = { (unsigned char)type, deferred };
+    *h = hash_bytes(*h, head, sizeof(head));
+    *h = hash_bytes(*h, &area, sizeof(area));
+    *h = hash_bytes(*h, &fg, sizeof(fg));
+    *h = hash_bytes(*h, &bg, sizeof(bg));
+    return h;
+}
+
+// Deferred mode: appends a command for the current layer. NULL when the list is full (caller draws directly).
+static draw_cmd *record_cmd(draw_cmd_type type, grect area, Color fg, Color bg) {
+    if (!cells) return NULL;
+    if (cmd_count == TM_MAX_COMMANDS) {
+        TraceLog(LOG_WARNING, "TMGUI: draw list full (TM_MAX_COMMANDS = %d), drawing in call order", TM_MAX_COMMANDS);
+        return NULL;
+    }
+    draw_cmd *cmd = &cmds[cmd_count++];
+    cmd->type = type;
+    cmd->layer = draw_layer;
+    cmd->area = area;
+    cmd->fg = fg;
+    cmd->bg = bg;
+    return cmd;
+}
+
+void tm_draw_fill_rect(grect area, Color color) {
+    hash_prim(CMD_FILL, area, BLANK, color);
+    if (deferred && record_cmd(CMD_FILL, area, BLANK, color)) return;
+    fill_rect_cells(area, color);
+}
 
-        // Fill background for character cell
-        tm_draw_fill_rect(char_cell, bg); // Use tm_draw_fill_rect as char_cell is a grect
+void tm_draw_fill_cell(grect cell, Color color) {
+    tm_draw_fill_rect((grect){ cell.x, cell.y, 1, 1 }, color);
+}
 
-        // Convert grid rect to pixel position
-        Rectangle px = grect_to_pixelrect(char_cell);
+void tm_draw_glyph(grect cell, atlaspos glyph, Color fg, Color bg) {
+    unsigned char page = atlas_active_page();
+    unsigned short index = atlas_index(page, glyph);
+    uint64_t *h = hash_prim(CMD_GLYPH, cell, fg, bg);
+    *h = hash_bytes(*h, &page, 1);
+    *h = hash_bytes(*h, &index, sizeof(index));
+    if (deferred) {
+        draw_cmd *cmd = record_cmd(CMD_GLYPH, cell, fg, bg);
+        if (cmd) { cmd->page = page; cmd->u.glyph = index; return; }
+    }
+    grid_cell *c = cell_at(cell.x, cell.y);
+    if (c) cell_put_glyph(c, page, index, ink_of(fg), ink_of(bg));
+}
 
-        // Draw the character at pixel position
-        DrawTextCodepoint(font, text[i], (Vector2){ px.x, px.y }, cell_h, fg);
+void tm_draw_text(const char *text, grect cell, Color fg, Color bg) {
+    unsigned char page = font_page(get_active_font());
+    uint64_t *h = hash_prim(CMD_TEXT, cell, fg, bg);
+    *h = hash_bytes(*h, &page, 1);
+    *h = hash_bytes(*h, text, strlen(text) + 1);
+
+    if (deferred) { // the string may not outlive the frame, keep a copy
+        int len = (int)strlen(text) + 1;
+        draw_cmd *cmd = (cmd_text_used + len <= TM_MAX_COMMAND_TEXT) ? record_cmd(CMD_TEXT, cell, fg, bg) : NULL;
+        if (cmd) {
+            cmd->page = page;
+            cmd->u.text = cmd_text_used;
+            memcpy(&cmd_text[cmd_text_used], text, len);
+            cmd_text_used += len;
+            return;
+        }
     }
+    text_cells(text, cell, page, fg, bg);
 }
 
 void tm_draw_panel(grect r) {
@@ -299,48 +3312,76 @@ void tm_draw_panel(grect r) {
 
     tm_panel_style style = current_theme.panel;
     panel_kit *kit = &style.kit;
-    Color fg = style.foreground;
-    Color bg = style.background;
-
-    // Fill panel background first
-    tm_draw_fill_rect(r, bg);
+    unsigned char page = atlas_active_page();
+    unsigned short parts[9];
+    bool strip = (r.h == 1);
 
-    if (r.h == 1) {
+    if (strip) {
         atlaspos left  = (kit->cap_l.x  >= 0) ? kit->cap_l  : kit->corner_tl;
         atlaspos right = (kit->cap_r.x >= 0) ? kit->cap_r : kit->corner_tr;
-
-        tm_draw_glyph(grect_offset(r, 0, 0), left, fg, bg);
-        for (int i = 1; i < r.w - 1; i++)
-            tm_draw_glyph(grect_offset(r, i, 0), kit->strip, fg, bg);
-        if (r.w > 1)
-            tm_draw_glyph(grect_offset(r, r.w - 1, 0), right, fg, bg);
-        return;
+        parts[0] = atlas_index(page, left);
+        parts[1] = atlas_index(page, kit->strip);
+        parts[2] = (r.w > 1) ? atlas_index(page, right) : parts[0];
+    } else {
+        const atlaspos box[9] = { kit->corner_tl, kit->edge_t, kit->corner_tr,
+                                  kit->edge_l,    kit->fill,   kit->edge_r,
+                                  kit->corner_bl, kit->edge_b, kit->corner_br };
+        for (int i = 0; i < 9; i++) parts[i] = atlas_index(page, box[i]);
     }
 
-    // Draw corners
-    tm_draw_glyph(grect_offset(r, 0, 0), kit->corner_tl, fg, bg);
-    tm_draw_glyph(grect_offset(r, r.w - 1, 0), kit->corner_tr, fg, bg);
-    tm_draw_glyph(grect_offset(r, 0, r.h - 1), kit->corner_bl, fg, bg);
-    tm_draw_glyph(grect_offset(r, r.w - 1, r.h - 1), kit->corner_br, fg, bg);
+    uint64_t *h = hash_prim(CMD_PANEL, r, style.foreground, style.background);
+    *h = hash_bytes(*h, &strip, sizeof(strip));
+    *h = hash_bytes(*h, &page, 1);
+    *h = hash_bytes(*h, parts, sizeof(parts));
 
-    // Draw top and bottom edges
-    for (int i = 1; i < r.w - 1; i++) {
-        tm_draw_glyph(grect_offset(r, i, 0), kit->edge_t, fg, bg);
-        tm_draw_glyph(grect_offset(r, i, r.h - 1), kit->edge_b, fg, bg);
+    if (deferred) {
+        draw_cmd *cmd = record_cmd(CMD_PANEL, r, style.foreground, style.background);
+        if (cmd) { cmd->strip = strip; cmd->page = page; memcpy(cmd->u.kit, parts, sizeof(parts)); return; }
     }
+    panel_cells(r, page, parts, strip, style.foreground, style.background);
+}
 
-    // Draw left and right edges
-    for (int j = 1; j < r.h - 1; j++) {
-        tm_draw_glyph(grect_offset(r, 0, j), kit->edge_l, fg, bg);
-        tm_draw_glyph(grect_offset(r, r.w - 1, j), kit->edge_r, fg, bg);
-    }
 
-    // Fill the interior
-    for (int i = 1; i < r.w - 1; i++) {
-        for (int j = 1; j < r.h - 1; j++) {
-            tm_draw_glyph(grect_offset(r, i, j), kit->fill, fg, bg);
+// --- DEFERRED DRAW LIST ---------------------------------------------------------------------------------
+// Replay is a stable counting sort by layer, so call order (and so overdraw) is kept within a layer.
+// Grouping by texture needs no sorting here: the cells resolve overdraw, and every page lives in the one
+// shared texture.
+
+void tm_set_deferred(bool on) {
+    deferred = on;
+}
+
+void tm_set_layer(int layer) {
+    draw_layer = layer < 0 ? 0 : (layer >= TM_MAX_LAYERS ? TM_MAX_LAYERS - 1 : layer);
+    if (cells) select_layer_cells(draw_layer);
+}
+
+static void replay_draw_list(void) {
+    static int order[TM_MAX_COMMANDS];
+    int start[TM_MAX_LAYERS + 1] = {0};
+
+    if (cmd_count == 0) return;
+    for (int i = 0; i < cmd_count; i++) start[cmds[i].layer + 1]++;
+    for (int l = 0; l < TM_MAX_LAYERS; l++) start[l + 1] += start[l];
+    for (int i = 0; i < cmd_count; i++) order[start[cmds[i].layer]++] = i;
+
+    int layer = -1;
+    for (int i = 0; i < cmd_count; i++) {
+        const draw_cmd *cmd = &cmds[order[i]];
+        if (cmd->layer != layer) select_layer_cells(layer = cmd->layer);
+        switch (cmd->type) {
+            case CMD_FILL:  fill_rect_cells(cmd->area, cmd->bg); break;
+            case CMD_GLYPH: {
+                grid_cell *c = cell_at(cmd->area.x, cmd->area.y);
+                if (c) cell_put_glyph(c, cmd->page, cmd->u.glyph, ink_of(cmd->fg), ink_of(cmd->bg));
+                break;
+            }
+            case CMD_TEXT:  text_cells(&cmd_text[cmd->u.text], cmd->area, cmd->page, cmd->fg, cmd->bg); break;
+            case CMD_PANEL: panel_cells(cmd->area, cmd->page, cmd->u.kit, cmd->strip, cmd->fg, cmd->bg); break;
         }
     }
+    cmd_count = 0;
+    cmd_text_used = 0;
 }
 
 
@@ -348,7 +3389,7 @@ void tm_draw_panel(grect r) {
 
 grect tm_text(const char *text, grect area) {
     grect txtpos;
-    grect final_area = get_area_and_txtpos(text, area, &txtpos);
+    grect final_area = get_area_and_txtpos(text, area, &txtpos, false);
     tm_draw_text(text, txtpos, current_theme.text.foreground, current_theme.text.background);
     return final_area;
 }
@@ -356,7 +3397,8 @@ grect tm_text(const char *text, grect area) {
 grect tm_label(const char *text, grect area) {
     grect txtpos;
     // HERE: final_area receives the returned value from the helper
-    grect final_area = get_area_and_txtpos(text, area, &txtpos);
+    grect final_area = get_area_and_txtpos(text, area, &txtpos, true);
+    widget_claim(last_widget, final_area);
     // AND HERE: final_area is USED to draw the full background
     tm_draw_fill_rect(final_area, current_theme.label.background);
     tm_draw_text(text, txtpos, current_theme.label.foreground, current_theme.label.background);
@@ -365,7 +3407,8 @@ grect tm_label(const char *text, grect area) {
 
 grect tm_label_panel(const char *text, grect area, int padding) { 
     grect txtpos;
-    grect final_area = get_area_and_txtpos(text, area, &txtpos); 
+    grect final_area = get_area_and_txtpos(text, area, &txtpos, true); 
+    widget_claim(last_widget, final_area);
     tm_draw_panel(final_area); 
     
     int margin_pad = 0; // padding to add from margin IF in left/right
@@ -389,22 +3432,30 @@ grect tm_label_panel(const char *text, grect area, int padding) {
     return final_area; 
 }
 
-/*bool tm_button(const char *label, grect r) { // WIP IGNORE
-    Font use_font = get_active_font();
-    Vector2 txt_px = MeasureTextEx(use_font, label, cell_h, 0);
-    int txt_w = pixels_to_grid_x(txt_px.x);
-
-    int w = (r.w > 0) ? r.w : (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > 0 ? gui_context.container_w : txt_w);
-    int h = (r.h > 0) ? r.h : 1;
-
-    grect final = (r.x < 0 && r.y < 0) ? tm_next_cell(w, h) : (grect){ r.x, r.y, w, h };
-
-    grect text_cell_aligned = tm_align_text_pos(final, txt_w, 1); // This now returns a CELL grect
+bool tm_button(const char *label, grect area) {
+    grect txtpos;
+    grect final_area = get_area_and_txtpos(label, area, &txtpos, true);
+    widget_state *ws = last_widget;
+    widget_claim(ws, final_area);
+    bool clicked = false;
+
+    if (ws) {
+        if (ws->hovered && tm_mouse_pressed(MOUSE_BUTTON_LEFT)) ws->active = true;
+        if (ws->active && tm_mouse_released(MOUSE_BUTTON_LEFT)) {
+            clicked = ws->hovered;
+            ws->active = false;
+        }
+    }
 
-    tm_draw_text(label, text_cell_aligned, current_theme.label.foreground, current_theme.label.background);
-}*/
+    const tm_button_style *style = &current_theme.button;
+    tm_textstyle look = (ws && ws->active) ? style->active : (ws && ws->hovered) ? style->hover : style->normal;
+    tm_draw_fill_rect(final_area, look.background);
+    tm_draw_text(label, txtpos, look.foreground, look.background);
+    return clicked;
+}
 
 grect tm_panel(grect area) {
+    stats.widgets++;
     // compute final rect as usual
     int w = (area.w > 0) ? area.w : (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > 0 ? gui_context.container_w : 1);
     int h = (area.h > 0) ? area.h : 1;
@@ -416,6 +3467,8 @@ grect tm_panel(grect area) {
         final = (grect){ area.x, area.y, w, h };
     }
 
+    // Panels have no label, they are told apart by call order within the scope
+    widget_claim(widget_begin(id_hash(id_scope(), "panel", 5)), final);
     tm_draw_panel(final);
     return final;
 }
@@ -452,6 +3505,221 @@ grect tm_panel_titled(const char *text, grect area, int pad) {
 }
 
 
+// --- Log ---
+#define LOG_WRAP_ROWS 64 // rows a single log line can wrap to, the rest is cut
+#define LOG_ROW_MAX 512
+
+void tm_log_init(tm_log_buffer *log, char *storage, int capacity, int line_len) {
+    *log = (tm_log_buffer){ storage, capacity, line_len, 0, 0, 0 };
+}
+
+void tm_log_push(tm_log_buffer *log, const char *line) {
+    if (!log->text || log->capacity <= 0 || log->line_len <= 0) return;
+    char *slot = &log->text[log->head * log->line_len];
+    strncpy(slot, line, log->line_len - 1);
+    slot[log->line_len - 1] = '\0';
+
+    log->head = (log->head + 1) % log->capacity;
+    if (log->count < log->capacity) log->count++;
+    if (log->scroll > 0) log->scroll++; // keep a scrolled back view where it is
+    if (log->scroll > log->count - 1) log->scroll = log->count - 1;
+}
+
+void tm_log_clear(tm_log_buffer *log) {
+    log->head = log->count = log->scroll = 0;
+}
+
+static const char *log_line(const tm_log_buffer *log, int back) { // 0 = newest
+    int slot = (log->head - 1 - back + log->capacity) % log->capacity;
+    return &log->text[slot * log->line_len];
+}
+
+// Word wraps a line to w cells: fills row start offsets, returns the row count (at least 1)
+static int log_wrap(const char *line, int len, int w, int starts[LOG_WRAP_ROWS]) {
+    int rows = 0, pos = 0;
+    do {
+        starts[rows++] = pos;
+        if (len - pos <= w) break;
+        int cut = pos + w;
+        while (cut > pos && line[cut] != ' ') cut--;
+        pos = (cut > pos) ? cut + 1 : pos + w; // no space: hard break mid word
+    } while (rows < LOG_WRAP_ROWS);
+    return rows;
+}
+
+static void log_scroll_input(tm_log_buffer *log, grect area) {
+    int scroll = log->scroll + (int)(input_now.wheel * 3);
+    if (tm_key_pressed(KEY_PAGE_UP)) scroll += area.h;
+    if (tm_key_pressed(KEY_PAGE_DOWN)) scroll -= area.h;
+    if (tm_key_pressed(KEY_END)) scroll = 0;
+    log->scroll = (scroll > log->count - 1) ? log->count - 1 : (scroll < 0 ? 0 : scroll);
+}
+
+grect tm_log(tm_log_buffer *log, grect area) {
+    stats.widgets++;
+    int w = (area.w > 0) ? area.w : (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > 0 ? gui_context.container_w : 1);
+    int h = (area.h > 0) ? area.h : 1;
+    grect final = (area.x < 0 && area.y < 0) ? tm_next_cell(w, h) : (grect){ area.x, area.y, w, h };
+    widget_state *ws = widget_begin(id_hash(id_scope(), &log, sizeof(log))); // the buffer is its identity
+    bool hovered = widget_hovered(ws, false);
+    widget_claim(ws, final);
+    if (!log->text || log->count == 0) return final;
+
+    if (hovered) log_scroll_input(log, final);
+
+    // Walk back from the newest shown line, filling rows bottom up until the area is full
+    Color fg = current_theme.text.foreground, bg = current_theme.text.background;
+    char row[LOG_ROW_MAX + 1];
+    int starts[LOG_WRAP_ROWS];
+    int y = final.y + final.h;
+    for (int back = log->scroll; back < log->count && y > final.y; back++) {
+        const char *line = log_line(log, back);
+        int len = (int)strlen(line);
+        int rows = log_wrap(line, len, w, starts);
+
+        for (int r = rows - 1; r >= 0 && y > final.y; r--) {
+            int end = (r + 1 < rows) ? starts[r + 1] : len;
+            int n = end - starts[r];
+            while (n > 0 && line[starts[r] + n - 1] == ' ') n--;
+            if (n > w) n = w;
+            if (n > LOG_ROW_MAX) n = LOG_ROW_MAX;
+            memcpy(row, line + starts[r], n);
+            row[n] = '\0';
+            tm_draw_text(row, CELL(final.x, --y), fg, bg);
+        }
+    }
+    return final;
+}
+
+
+// --- List / Table ---
+
+// Shared by tm_list and tm_table: input, scroll clamping and the scrollbar. Returns the area left for rows
+// and how many of them fit.
+// Keys go to the list that was clicked last (its widget is active until a click lands elsewhere), the wheel
+// and clicks to the one under the mouse. Without a widget entry (table full) keys fall back to hover.
+static grect list_view(tm_list_state *st, widget_state *ws, int count, int row_h, grect area, bool hovered, int *visible) {
+    grect rows = area;
+    *visible = rows.h / row_h;
+    bool bar = count > *visible && rows.w > 1;
+    if (bar) rows.w--;
+
+    if (ws && tm_mouse_pressed(MOUSE_BUTTON_LEFT)) ws->active = hovered;
+    bool focused = ws ? ws->active : hovered;
+    grect mc = mouse_cell;
+    if ((hovered || focused) && *visible > 0) { // no rows shown: nothing to move through
+        int first = st->first - (hovered ? (int)(input_now.wheel * 3) : 0);
+        int sel = st->selected;
+        if (focused) {
+            if (key_step(KEY_DOWN)) sel++;
+            if (key_step(KEY_UP)) sel--;
+            if (key_step(KEY_PAGE_DOWN)) sel += *visible;
+            if (key_step(KEY_PAGE_UP)) sel -= *visible;
+            if (tm_key_pressed(KEY_HOME)) sel = 0;
+            if (tm_key_pressed(KEY_END)) sel = count - 1;
+        }
+        if (hovered && tm_mouse_pressed(MOUSE_BUTTON_LEFT) && rect_contains_cell(rows, mc)) {
+            int row = (mc.y - rows.y) / row_h; // below the last item or in the spare cells under the last full row: none
+            if (row < *visible && first + row < count) sel = first + row;
+        }
+
+        if (sel != st->selected && count > 0) { // moved by keys or click: keep it in view
+            sel = (sel < 0) ? 0 : (sel >= count ? count - 1 : sel);
+            if (sel < first) first = sel;
+            if (sel >= first + *visible) first = sel - *visible + 1;
+            st->selected = sel;
+        }
+        st->first = first;
+    }
+    int max_first = (count > *visible) ? count - *visible : 0;
+    st->first = (st->first > max_first) ? max_first : (st->first < 0 ? 0 : st->first);
+    if (st->selected >= count) st->selected = count - 1;
+
+    if (bar) {
+        int track = area.h, thumb = track * *visible / count;
+        if (thumb < 1) thumb = 1;
+        int pos = (track - thumb) * st->first / max_first;
+        tm_draw_fill_rect((grect){ area.x + area.w - 1, area.y, 1, track }, current_theme.panel.background);
+        tm_draw_fill_rect((grect){ area.x + area.w - 1, area.y + pos, 1, thumb }, current_theme.panel.foreground);
+    }
+    return rows;
+}
+
+static grect list_area(grect area) {
+    int w = (area.w > 0) ? area.w : (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > 0 ? gui_context.container_w : 1);
+    int h = (area.h > 0) ? area.h : 1;
+    return (area.x < 0 && area.y < 0) ? tm_next_cell(w, h) : (grect){ area.x, area.y, w, h };
+}
+
+// The list owns its area, the widgets in its rows claim over it and still count as hovering the list
+static widget_state *list_begin(tm_list_state *state, grect final, bool *hovered) {
+    widget_state *ws = widget_begin(id_hash(id_scope(), &state, sizeof(state)));
+    *hovered = widget_hovered(ws, true);
+    widget_claim(ws, final);
+    if (ws) ws->hovered = *hovered;
+    return ws;
+}
+
+grect tm_list(tm_list_state *state, int count, int row_h, tm_list_row_fn draw_row, void *user, grect area) {
+    stats.widgets++;
+    grect final = list_area(area);
+    if (row_h < 1) row_h = 1;
+
+    bool hovered;
+    widget_state *ws = list_begin(state, final, &hovered);
+    int visible;
+    grect rows = list_view(state, ws, count, row_h, final, hovered, &visible);
+    for (int i = 0; i < visible && state->first + i < count; i++) {
+        int row = state->first + i;
+        grect r = { rows.x, rows.y + i * row_h, rows.w, row_h };
+        if (row == state->selected) tm_draw_fill_rect(r, current_theme.label.background);
+        tm_push_id_int(row); // widgets in the row keep their state while the list scrolls
+        draw_row(row, r, user);
+        tm_pop_id();
+    }
+    if (ws) ws->claim_end = claim_seq;
+    return final;
+}
+
+grect tm_table(tm_list_state *state, const tm_column *cols, int col_count, int count, tm_table_row_fn draw_row, void *user, grect area) {
+    stats.widgets++;
+    grect final = list_area(area);
+    if (col_count > TM_MAX_COLUMNS) col_count = TM_MAX_COLUMNS;
+
+    // Header row, the rows scroll below it
+    bool hovered;
+    widget_state *ws = list_begin(state, final, &hovered);
+    grect body = { final.x, final.y + 1, final.w, final.h - 1 };
+    int visible;
+    grect rows = list_view(state, ws, count, 1, body, hovered, &visible);
+
+    grect col_rect[TM_MAX_COLUMNS];
+    int x = rows.x, right = rows.x + rows.w;
+    for (int c = 0; c < col_count; c++) {
+        int w = (cols[c].width > 0) ? cols[c].width : right - x;
+        if (x + w > right) w = right - x;
+        col_rect[c] = (grect){ x, 0, w < 0 ? 0 : w, 1 };
+        x += col_rect[c].w;
+    }
+
+    tm_draw_fill_rect((grect){ final.x, final.y, final.w, 1 }, current_theme.label.background);
+    for (int c = 0; c < col_count; c++)
+        if (cols[c].title && col_rect[c].w > 0)
+            tm_draw_text(cols[c].title, CELL(col_rect[c].x, final.y), current_theme.label.foreground, current_theme.label.background);
+
+    for (int i = 0; i < visible && state->first + i < count; i++) {
+        int row = state->first + i;
+        for (int c = 0; c < col_count; c++) col_rect[c].y = rows.y + i;
+        if (row == state->selected) tm_draw_fill_rect((grect){ rows.x, rows.y + i, rows.w, 1 }, current_theme.label.background);
+        tm_push_id_int(row);
+        draw_row(row, col_rect, col_count, user);
+        tm_pop_id();
+    }
+    if (ws) ws->claim_end = claim_seq;
+    return final;
+}
+
+
 //---------------------------------------------------------------------------------------------------------
 //---------------------------------------------------------------------------------------------------------
 // --- LAYOUT ---------------------------------------------------------------------------------------------
@@ -462,25 +3730,137 @@ grect tm_next_cell(int w, int h) {
     if (gui_context.mode == LAYOUT_HBOX) gui_context.cursor_x += w + layout_spacing;
     else if (gui_context.mode == LAYOUT_VBOX) gui_context.cursor_y += h + layout_spacing;
 
+    // Content extent, what an AUTO sized parent box gets measured at
+    if (x + w - gui_context.origin_x > gui_context.extent_w) gui_context.extent_w = x + w - gui_context.origin_x;
+    if (y + h - gui_context.origin_y > gui_context.extent_h) gui_context.extent_h = y + h - gui_context.origin_y;
+
     return (grect){ x, y, w, h };
 }
 
+static void layout_start(layout_mode mode, int x, int y) {
+    layout_seq++;
+    layout_scope = id_hash(0, &layout_seq, sizeof(layout_seq)); // widgets in here get their own ID scope
+    gui_context.mode = mode;
+    gui_context.cursor_x = gui_context.origin_x = x;
+    gui_context.cursor_y = gui_context.origin_y = y;
+    gui_context.extent_w = gui_context.extent_h = 0;
+}
+
 void tm_vbox(grect area) {
-    gui_context.mode = LAYOUT_VBOX;
-    gui_context.cursor_x = (area.x < 0 ? 0 : area.x);
-    gui_context.cursor_y = (area.y < 0 ? 0 : area.y);
+    layout_start(LAYOUT_VBOX, area.x < 0 ? 0 : area.x, area.y < 0 ? 0 : area.y);
     gui_context.container_w = area.w; // ← Set container width
 }
 
 void tm_hbox(grect area) {
-    gui_context.mode = LAYOUT_HBOX;
-    gui_context.cursor_x = (area.x < 0 ? 0 : area.x);
-    gui_context.cursor_y = (area.y < 0 ? 0 : area.y);
+    layout_start(LAYOUT_HBOX, area.x < 0 ? 0 : area.x, area.y < 0 ? 0 : area.y);
     gui_context.container_h = area.h; // ← Set container width
 }
 
+// --- Container stack ---
+static grect box_begin(layout_mode mode, grect area) {
+    widget_state *ws = widget_begin(id_hash(id_scope(), "box", 3)); // call order within the parent scope
+    int pad = layout_padding;
+
+    // Explicit size, else last frames measure, stretched across the parent like an element would be
+    int w = (ws ? ws->content_w : 0) + 2 * pad;
+    int h = (ws ? ws->content_h : 0) + 2 * pad;
+    if (area.w > 0) w = area.w;
+    else if (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > w) w = gui_context.container_w;
+    if (area.h > 0) h = area.h;
+    else if (gui_context.mode == LAYOUT_HBOX && gui_context.container_h > h) h = gui_context.container_h;
+
+    grect final;
+    if (area.x < 0 && area.y < 0) {
+        final = tm_next_cell(w, h);
+        if (gui_context.mode == LAYOUT_VBOX && gui_context.container_w > 0) { // same as elements
+            if (h_align == ALIGN_CENTER) final.x += (gui_context.container_w - w) / 2;
+            else if (h_align == ALIGN_RIGHT) final.x += gui_context.container_w - w;
+        }
+    } else {
+        final = (grect){ area.x, area.y, w, h };
+    }
+
+    if (layout_depth == TM_MAX_NESTING) { // its content goes to the parent, the matching tm_box_end pops nothing
+        layout_overflow++;
+        if (!layout_overflow_warned) TraceLog(LOG_WARNING, "TMGUI: containers nested deeper than TM_MAX_NESTING (%d)", TM_MAX_NESTING);
+        layout_overflow_warned = true;
+        return final;
+    }
+    layout_stack[layout_depth++] = (layout_frame){ gui_context, layout_scope, ws, area };
+
+    layout_start(mode, final.x + pad, final.y + pad);
+    gui_context.container_w = final.w - 2 * pad;
+    gui_context.container_h = final.h - 2 * pad;
+    return final;
+}
+
+grect tm_vbox_begin(grect area) {
+    return box_begin(LAYOUT_VBOX, area);
+}
+
+grect tm_hbox_begin(grect area) {
+    return box_begin(LAYOUT_HBOX, area);
+}
+
+grect tm_box_end(void) {
+    grect content = { gui_context.origin_x, gui_context.origin_y, gui_context.extent_w, gui_context.extent_h };
+    if (layout_overflow > 0) {
+        layout_overflow--;
+        return content;
+    }
+    if (layout_depth == 0) return content;
+    layout_frame *f = &layout_stack[--layout_depth];
+
+    // Remember the measure for next frame. If an AUTO dimension used a different one, the frame is not settled.
+    if (f->ws && (f->ws->content_w != content.w || f->ws->content_h != content.h)) {
+        if (f->area.w <= 0 || f->area.h <= 0) tm_request_frame();
+        f->ws->content_w = (short)content.w;
+        f->ws->content_h = (short)content.h;
+    }
+    gui_context = f->parent;
+    layout_scope = f->parent_scope;
+    return content;
+}
+
 // --- DEVTOOLS ---
+
+// raylib text for the glyph tool, made from the fallback font's cell page: the same lazy / embedded page the
+// cells use, uploaded once more as a texture of its own
+static Font devtool_font_load(void) {
+    static GlyphInfo glyphs[95];
+    static Rectangle recs[95];
+    int page = font_page(fallback_font);
+    const glyph_page *p = &pages[page];
+    const font_slot *slot = &fonts[page - TM_PAGE_FONT];
+    Font font = { 0 };
+    if (p->image.data == NULL || p->cols == 0) return font;
+    for (int i = 0; i < 95; i++) {
+        int g = slot->lut[32 + i];
+        recs[i] = (Rectangle){ (float)(g % p->cols * cell_w), (float)(g / p->cols * cell_h), (float)cell_w, (float)cell_h };
+        glyphs[i] = (GlyphInfo){ .value = 32 + i, .advanceX = cell_w };
+    }
+    font.baseSize = cell_h;
+    font.glyphCount = 95;
+    font.recs = recs;
+    font.glyphs = glyphs;
+    font.texture = LoadTextureFromImage(p->image);
+    SetTextureFilter(font.texture, TEXTURE_FILTER_POINT);
+    return font;
+}
+
 void glyph_tool(void) {
+    static const glyph_page *shown = NULL; // the active sheet, copied into a texture of its own for drawing
+    static unsigned int shown_generation = 0;
+    const glyph_page *sheet = atlas_page(atlas_active_page() - TM_PAGE_ATLAS);
+    if (glyph_atlas.id == 0 || shown != sheet || shown_generation != page_generation) {
+        UnloadTexture(glyph_atlas);
+        glyph_atlas = LoadTextureFromImage(sheet->image);
+        SetTextureFilter(glyph_atlas, TEXTURE_FILTER_POINT);
+        shown = sheet;
+        shown_generation = page_generation;
+    }
+    if (devtool_font.glyphs == NULL) devtool_font = devtool_font_load();
+
     int atlas_columns = glyph_atlas.width / cell_w;
     int atlas_rows = glyph_atlas.height / cell_h;
 
@@ -502,7 +3882,7 @@ void glyph_tool(void) {
                   (atlas_columns + 2) * glyph_draw_width, (atlas_rows + 2) * glyph_draw_height, BLACK);
     DrawRectangleLines(grid_origin_x - glyph_draw_width, grid_origin_y - glyph_draw_height,
                        (atlas_columns + 2) * glyph_draw_width, (atlas_rows + 2) * glyph_draw_height, GREEN);
-    DrawTextEx(fallback_font, "GLYPH TOOL",
+    DrawTextEx(devtool_font, "GLYPH TOOL",
                (Vector2){ grid_origin_x - 32, grid_origin_y - 2 * glyph_draw_height },
                glyph_draw_height, 0, GREEN);
 
@@ -530,7 +3910,7 @@ void glyph_tool(void) {
         hovered_cell_y >= 0 && hovered_cell_y < atlas_rows) {
         char buf[32];
         snprintf(buf, sizeof(buf), "[%d,%d]", hovered_cell_x, hovered_cell_y);
-        DrawTextEx(fallback_font, buf,
+        DrawTextEx(devtool_font, buf,
                    (Vector2){ grid_origin_x + (atlas_columns - 5) * glyph_draw_width,
                               grid_origin_y + (atlas_rows + 1) * glyph_draw_height },
                    glyph_draw_height, 0, GREEN);
@@ -604,7 +3984,7 @@ void glyph_tool(void) {
 
     for (int i = scroll_start, visible_index = 0; i < log_count; i++, visible_index++) {
         Vector2 pos = { log_x + glyph_draw_width, log_y + (visible_index + 2) * line_height };
-        DrawTextEx(fallback_font, log[i].text, pos, line_height, 0, GREEN);
+        DrawTextEx(devtool_font, log[i].text, pos, line_height, 0, GREEN);
 
         if (log[i].glyph) {
             Rectangle src = { log[i].x * cell_w, log[i].y * cell_h, cell_w, cell_h };
@@ -662,13 +4042,21 @@ void glyph_tool(void) {
 //---------------------------------------------------------------------------------------------------------
 //---------------------------------------------------------------------------------------------------------
 // --- TEST / MAIN -----------------------------------------------------------------------------------------------
-
+// Build with -DTMGUI_NO_DEMO to link tmgui into another program (e.g. bench/tm_bench.c)
+#ifndef TMGUI_NO_DEMO
 
 // Test font declarations (as per your request)
 Font customfont0;
 Font customfont1;
 Font customfont2;
 
+static const char *ITEMS[] = { "BENT STRAW", "DOG FUR", "MANS HAT", "STRAW", "OLD SOCK", "BONE" };
+#define ITEM_COUNT ((int)(sizeof(ITEMS) / sizeof(ITEMS[0])))
+
+static void draw_item(int row, grect area, void *user) {
+    (void)user;
+    tm_label(ITEMS[row], RECT(area.x, area.y, area.w, 3));
+}
 
 
 int main(void) {
@@ -679,29 +4067,42 @@ int main(void) {
     InitWindow(gw * cw * 2, gh * ch * 2, "TMGUI Dungeon HUD (Revised)");
     tmgui_init(cw, ch);
     SetTargetFPS(60);
+    EnableEventWaiting(); // idle on static screens, see tm_frame_needed below
 
-    // Load custom fonts (as per your request)
-    customfont0 = LoadFontEx("C:/Code/tmgui/fonts/URSA.ttf", cell_h, NULL, 0);
-    customfont1 = LoadFontEx("C:/Code/tmgui/fonts/DUNGEONMODE.ttf", cell_h, NULL, 0);
-    customfont2 = LoadFontEx("C:/Code/tmgui/fonts/KITCHENSINK.ttf", cell_h, NULL, 0);
-    SetTextureFilter(customfont0.texture, TEXTURE_FILTER_POINT);
-    SetTextureFilter(customfont1.texture, TEXTURE_FILTER_POINT);
-    SetTextureFilter(customfont2.texture, TEXTURE_FILTER_POINT);
+    // Load custom fonts (as per your request), baked on the asset worker while the first frames draw
+    customfont0 = tm_load_font_async(TM_ASSET_DIR "fonts/URSA.ttf");
+    customfont1 = tm_load_font_async(TM_ASSET_DIR "fonts/DUNGEONMODE.ttf");
+    customfont2 = tm_load_font_async(TM_ASSET_DIR "fonts/KITCHENSINK.ttf");
+    tm_atlas dungeon_tiles = tm_load_atlas_async(TM_ASSET_DIR "glyphs/T_DUNGEON.png"); // second sheet, same texture
+    tm_watch_assets(true); // edit fonts/ or glyphs/ while this runs
 
     tm_canvas canvas = tm_canvas_init(gw, gh, false);
 
+    tm_list_state items_view = { 0, -1 };
+    static char log_lines[4096][96];
+    tm_log_buffer combat_log;
+    tm_log_init(&combat_log, &log_lines[0][0], 4096, 96);
+    for (int i = 0; i < 4; i++) tm_log_push(&combat_log, ">you ate the poopo bug");
+    int bugs_eaten = 4;
+
     // Set a custom theme for the main UI
     tm_set_theme(&THEME_GREEN);
   
 
 
     while (!WindowShouldClose()) {
+    // Nothing changed: block in PollInputEvents until the next event instead of redrawing
+    if (!show_tilepicker && !tm_frame_needed()) { PollInputEvents(); continue; }
     if (IsKeyPressed(KEY_TAB)) {show_tilepicker = !show_tilepicker;}
+    if (IsKeyPressed(KEY_F3)) tm_show_stats(!tm_stats_shown());
+    if (IsKeyPressed(KEY_SPACE)) {
+        char line[96];
+        snprintf(line, sizeof(line), ">you ate the poopo bug (%d so far, it keeps getting worse and the log keeps wrapping)", ++bugs_eaten);
+        tm_log_push(&combat_log, line);
+    }
 
     tm_canvas_begin(&canvas);
 
-    ClearBackground(BLACK); // A darker background to highlight UI elements
-
 
     tm_set_spacing(1);
     ALIGN(LEFT, TOP);
@@ -718,10 +4119,7 @@ ALIGN(LEFT,CENTER);
 tm_vbox(RECT(26,33,54,16));
 tm_label("", AUTO);
 tm_label_panel("ACTIONS",SIZE(9,3),-1);
-tm_text(">you ate the poopo bug", AUTO);
-tm_text(">you ate the poopo bug", AUTO);
-tm_text(">you ate the poopo bug", AUTO);
-tm_text(">you ate the poopo bug", AUTO);
+tm_log(&combat_log, SIZE(-1, 7)); // SPACE adds a line, wheel scrolls
 
 
 // --- VBOX A: List of Labels and Text (your original example) ---
@@ -740,10 +4138,7 @@ tm_vbox(RECT(1,1,11,45)); // This sets gui_context for elements in this Vbox
     tm_text("ITEMS",SIZE(11,1));
 
     ALIGN(CENTER,CENTER);
-    tm_label("BENT STRAW",SIZE(11,3));
-    tm_label("DOG FUR",SIZE(11,3));
-    tm_label("MANS HAT",SIZE(11,3));
-    tm_label("STRAW",SIZE(11,3));
+    tm_list(&items_view, ITEM_COUNT, 4, draw_item, NULL, SIZE(11,16)); // one row per item, only visible rows are drawn
 
 // --- VBOX B: Panels with children (your expanded weirdos list) ---
 // This call *overwrites* gui_context, ending Vbox A's context and starting Vbox B's
@@ -767,7 +4162,9 @@ tm_vbox(RECT(13 ,2,14,45)); // start Vbox B. Increased width to 14 for content.
     tm_text(">Drain Life",OFFSET(p1,1,3));
 
     // Character 4: Zarthus
+    tm_set_atlas(&dungeon_tiles); // his panel is drawn from the dungeon sheet
     grect p3 = tm_panel(SIZE(14,5)); // Panel 3: Auto-positioned within Vbox B
+    tm_set_atlas(NULL);
     tm_label("Zarthus",RELRECT(p3,0,0,8,1));
     tm_text("PWR: 5",OFFSET(p3,1,1));
     tm_text("SKI: 7",OFFSET(p3,1,2));
@@ -787,11 +4184,8 @@ if (show_tilepicker) {
         EndDrawing();
     }
 
-    // Unload fonts
-    UnloadFont(customfont0);
-    UnloadFont(customfont1);
-    UnloadFont(customfont2);
-    tmgui_shutdown(); // Unloads current_font and glyph_atlas
+    tmgui_shutdown(); // Unloads the font pages and the glyph atlas
     CloseWindow();
     return 0;
-}
\ No newline at end of file
+}
+#endif // TMGUI_NO_DEMO
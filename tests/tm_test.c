@@ -0,0 +1,688 @@
+// TMGUI behavior checks. Headless: no window, cells are read back with tm_canvas_cells from the null backend
+// and input is injected, so every run sees the same frames.
+//
+// Build and run from the repo root (raylib on the include/lib path), once more with -DTM_PALETTE_CELLS:
+//   cc -std=c99 -O2 -Iinclude -DTMGUI_NO_DEMO tests/tm_test.c lib/tmgui.c -lraylib -lm -o tm_test && ./tm_test
+//
+// Usage: tm_test [--filter name]
+// Prints each failed check and a summary line, exits non-zero when anything failed.
+
+#include "tmgui.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static int checks = 0, failures = 0;
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static void check(bool ok, const char *what, int line) {
+    checks++;
+    if (ok) return;
+    failures++;
+    printf("  FAIL line %d: %s\n", line, what);
+}
+
+static bool color_is(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// tm_canvas_cells of both canvases are the same. Copied first, with TM_PALETTE_CELLS the result only lives
+// until the next call.
+static bool same_cells(const tm_canvas *a, const tm_canvas *b) {
+    static tm_cell copy[200 * 100];
+    int n = a->grid_w * a->grid_h;
+    if (n != b->grid_w * b->grid_h || n > (int)(sizeof(copy) / sizeof(copy[0]))) return false;
+    memcpy(copy, tm_canvas_cells(a), sizeof(tm_cell) * n);
+    const tm_cell *other = tm_canvas_cells(b);
+    for (int i = 0; i < n; i++) {
+        if (copy[i].glyph != other[i].glyph || copy[i].page != other[i].page) return false;
+        if (!color_is(copy[i].fg, other[i].fg) || !color_is(copy[i].bg, other[i].bg)) return false;
+    }
+    return true;
+}
+
+// One frame with fixed input: the mouse over a cell, no buttons
+static void begin_frame(tm_canvas *c, float mouse_x, float mouse_y) {
+    tm_input in = { 0 };
+    in.frame_time = 1.0f / 60.0f;
+    in.mouse = (Vector2){ mouse_x, mouse_y };
+    tm_input_inject(&in);
+    tm_canvas_begin(c);
+}
+
+// --- Checks ---------------------------------------------------------------------------------------------
+
+static void test_input_script(void) { // snapshots in script order, press / release edges, one per frame
+    tm_canvas a = tm_canvas_init(10, 5, false), b = tm_canvas_init(10, 5, false);
+    tm_input script[5];
+    memset(script, 0, sizeof(script));
+    for (int f = 0; f < 5; f++) {
+        script[f].frame_time = 1.0f / 60.0f;
+        script[f].mouse = (Vector2){ 1.0f + f, 2.0f };
+    }
+    script[1].buttons = script[2].buttons = 1 << MOUSE_BUTTON_LEFT;
+    script[1].key_count = 1;
+    script[1].keys[0] = KEY_DOWN;
+    script[2].key_count = 1;
+    script[2].keys[0] = KEY_DOWN;
+    script[2].key_repeat = 1;
+
+    // Canvas b was not begun yet this frame, a new script still starts the next frame with its first snapshot
+    begin_frame(&a, -1, -1);
+    tm_canvas_end(&a);
+    tm_input_script(script, 5);
+    CHECK(tm_input_script_left() == 5);
+    bool pressed[5], released[5], key[5], order = true;
+    for (int f = 0; f < 5; f++) {
+        tm_canvas_begin(&b);
+        order = order && tm_input_get()->mouse.x == script[f].mouse.x;
+        pressed[f] = tm_mouse_pressed(MOUSE_BUTTON_LEFT);
+        released[f] = tm_mouse_released(MOUSE_BUTTON_LEFT);
+        key[f] = tm_key_pressed(KEY_DOWN);
+        tm_canvas_end(&b);
+        CHECK(tm_input_script_left() == 4 - f);
+    }
+    CHECK(order);
+    CHECK(!pressed[0] && pressed[1] && !pressed[2] && !pressed[3] && !pressed[4]);
+    CHECK(!released[0] && !released[1] && !released[2] && released[3] && !released[4]);
+    CHECK(!key[0] && key[1] && !key[2]); // the repeat is not a press
+    tm_input_script(NULL, 0);
+
+    // Two canvases in one frame share the snapshot and both see the press, the next frame does not
+    tm_input in = { 0 };
+    in.buttons = 1 << MOUSE_BUTTON_LEFT;
+    begin_frame(&a, -1, -1); // released before
+    tm_canvas_end(&a);
+    tm_input_inject(&in);
+    tm_canvas_begin(&a);
+    bool seen_a = tm_mouse_pressed(MOUSE_BUTTON_LEFT);
+    tm_canvas_end(&a);
+    tm_canvas_begin(&b);
+    bool seen_b = tm_mouse_pressed(MOUSE_BUTTON_LEFT);
+    tm_canvas_end(&b);
+    tm_input_inject(&in);
+    tm_canvas_begin(&a);
+    bool seen_again = tm_mouse_pressed(MOUSE_BUTTON_LEFT); // still held, no new edge
+    tm_canvas_end(&a);
+    CHECK(seen_a && seen_b && !seen_again);
+    tm_canvas_unload(&a);
+    tm_canvas_unload(&b);
+}
+
+static void test_log_ring(void) { // ring buffer order, overwrite and cut, rendered newest at the bottom
+    static char storage[4 * 8];
+    tm_log_buffer log;
+    tm_log_init(&log, storage, 4, 8);
+    const char *lines[6] = { "one", "two", "three", "four", "five", "six" };
+    for (int i = 0; i < 6; i++) tm_log_push(&log, lines[i]);
+    CHECK(log.count == 4);
+    CHECK(log.head == 6 % 4);
+    CHECK(strcmp(&storage[((log.head + 3) % 4) * 8], "six") == 0);   // newest
+    CHECK(strcmp(&storage[log.head * 8], "three") == 0);             // oldest kept
+    tm_log_push(&log, "a line too long");
+    CHECK(strcmp(&storage[((log.head + 3) % 4) * 8], "a line ") == 0); // line_len - 1 bytes
+
+    // The last three lines fill a 3 row area bottom up, the same cells as plain texts
+    tm_log_clear(&log);
+    CHECK(log.count == 0 && log.head == 0);
+    for (int i = 0; i < 6; i++) tm_log_push(&log, lines[i]);
+    tm_canvas a = tm_canvas_init(10, 3, false), b = tm_canvas_init(10, 3, false);
+    begin_frame(&a, -1, -1);
+    tm_log(&log, RECT(0, 0, 10, 3));
+    tm_canvas_end(&a);
+    begin_frame(&b, -1, -1);
+    for (int i = 0; i < 3; i++) tm_text(lines[3 + i], RECT(0, i, 0, 0));
+    tm_canvas_end(&b);
+    CHECK(same_cells(&a, &b));
+
+    // Scrolled back one line, a push keeps the view on the same lines. "three" was overwritten, the top row
+    // stays empty.
+    log.scroll = 1;
+    tm_log_push(&log, "seven");
+    CHECK(log.scroll == 2);
+    begin_frame(&a, -1, -1);
+    tm_log(&log, RECT(0, 0, 10, 3));
+    tm_canvas_end(&a);
+    begin_frame(&b, -1, -1);
+    for (int i = 1; i < 3; i++) tm_text(lines[2 + i], RECT(0, i, 0, 0));
+    tm_canvas_end(&b);
+    CHECK(same_cells(&a, &b));
+
+    tm_canvas_unload(&a);
+    tm_canvas_unload(&b);
+}
+
+static void test_id_stack(void) { // scopes, balanced pops and overflow, retained state kept apart
+    tm_canvas c = tm_canvas_init(20, 10, false);
+    begin_frame(&c, -1, -1);
+    tm_id top = tm_get_id("X");
+    tm_push_id("a");
+    tm_id in_a = tm_get_id("X");
+    tm_pop_id();
+    tm_push_id("b");
+    tm_id in_b = tm_get_id("X");
+    tm_pop_id();
+    CHECK(in_a != top && in_b != top && in_a != in_b);
+    CHECK(tm_get_id("X") == top);
+    tm_push_id_int(1);
+    tm_id row1 = tm_get_id("X");
+    tm_pop_id();
+    tm_push_id_int(2);
+    CHECK(tm_get_id("X") != row1);
+    tm_pop_id();
+
+    // Pushes past TM_ID_STACK_DEPTH are dropped but still counted: the same number of pops gets back to the
+    // enclosing scope, not past it
+    tm_push_id("outer");
+    tm_id outer = tm_get_id("X");
+    for (int i = 0; i < TM_ID_STACK_DEPTH + 4; i++) tm_push_id_int(i);
+    tm_id deepest = tm_get_id("X");
+    for (int i = 0; i < 4; i++) tm_pop_id();
+    CHECK(tm_get_id("X") == deepest); // only dropped pushes popped so far
+    for (int i = 0; i < TM_ID_STACK_DEPTH; i++) tm_pop_id();
+    CHECK(tm_get_id("X") == outer);
+    tm_pop_id();
+    CHECK(tm_get_id("X") == top);
+    tm_pop_id(); // unbalanced at the top: stays on the canvas scope
+    CHECK(tm_get_id("X") == top);
+
+    // Same label in two scopes or twice in one scope: separate widgets. Plain text has no ID.
+    tm_push_id("a");
+    tm_button("OK", RECT(0, 0, 4, 1));
+    tm_id ok_a = tm_last_id();
+    tm_pop_id();
+    tm_push_id("b");
+    tm_button("OK", RECT(0, 1, 4, 1));
+    tm_id ok_b = tm_last_id();
+    tm_button("OK", RECT(0, 2, 4, 1));
+    tm_id ok_b2 = tm_last_id();
+    tm_pop_id();
+    CHECK(ok_a != 0 && ok_b != 0 && ok_b2 != 0);
+    CHECK(ok_a != ok_b && ok_b != ok_b2 && ok_a != ok_b2);
+    tm_text("OK", RECT(0, 3, 2, 1));
+    CHECK(tm_last_id() == 0);
+    tm_canvas_end(&c);
+
+    // Next frame, same calls: same IDs
+    begin_frame(&c, -1, -1);
+    tm_push_id("a");
+    tm_button("OK", RECT(0, 0, 4, 1));
+    CHECK(tm_last_id() == ok_a);
+    tm_pop_id();
+    tm_canvas_end(&c);
+    tm_canvas_unload(&c);
+}
+
+static void test_box_nesting(void) { // begins dropped past TM_MAX_NESTING are ended without popping the parent
+    tm_canvas c = tm_canvas_init(40, 20, false);
+    for (int f = 0; f < 2; f++) {
+        begin_frame(&c, -1, -1);
+        tm_vbox_begin(RECT(2, 2, 0, 0));
+        tm_label("A", AUTO);
+        tm_id scope = tm_get_id("X");
+        for (int i = 0; i < TM_MAX_NESTING + 3; i++) tm_vbox_begin(AUTO);
+        for (int i = 0; i < TM_MAX_NESTING + 3; i++) tm_box_end();
+        CHECK(tm_get_id("X") == scope);
+        grect b = tm_label("B", AUTO); // still in the outer box, under A
+        CHECK(b.x == 2 && b.y == 3);
+        tm_box_end();
+        tm_canvas_end(&c);
+    }
+    tm_canvas_unload(&c);
+}
+
+static void list_row(int row, grect area, void *user) {
+    (void)user;
+    char text[16];
+    snprintf(text, sizeof(text), "ROW %d", row);
+    tm_text(text, area);
+}
+
+static void list_click(tm_canvas *c, tm_list_state *st, int count, int row_h, grect area, float x, float y) {
+    for (int f = 0; f < 2; f++) { // press over the list, release
+        tm_input in = { 0 };
+        in.frame_time = 1.0f / 60.0f;
+        in.mouse = (Vector2){ x, y };
+        in.buttons = (f == 0) ? 1 << MOUSE_BUTTON_LEFT : 0;
+        tm_input_inject(&in);
+        tm_canvas_begin(c);
+        tm_list(st, count, row_h, list_row, NULL, area);
+        tm_canvas_end(c);
+    }
+}
+
+static void frame_skip_frame(tm_canvas *c, const char *text) {
+    begin_frame(c, -1, -1);
+    tm_draw_text(text, CELL(2, 1), WHITE, BLACK);
+    tm_draw_fill_rect(RECT(0, 3, 20, 2), BLUE);
+    tm_canvas_end(c);
+}
+
+static void test_frame_skip(void) { // an unchanged frame hashes equal and draws nothing, until tmgui_shutdown resets it
+    tm_canvas c = tm_canvas_init(20, 6, false);
+    frame_skip_frame(&c, "one");
+    int first = tm_get_stats()->cells_drawn;
+    CHECK(first == 20 * 6); // a new canvas draws every cell
+    frame_skip_frame(&c, "one");
+    CHECK(tm_get_stats()->cells_drawn == 0);
+    frame_skip_frame(&c, "two");
+    CHECK(tm_get_stats()->cells_drawn == 3); // the diff finds the changed text only
+    frame_skip_frame(&c, "two");
+    CHECK(tm_get_stats()->cells_drawn == 0);
+
+    // The canvas outlives a shutdown: its target may be gone, so the same frame draws in full again
+    tmgui_shutdown();
+    tmgui_init(8, 8);
+    frame_skip_frame(&c, "two");
+    CHECK(tm_get_stats()->cells_drawn == first);
+    frame_skip_frame(&c, "two");
+    CHECK(tm_get_stats()->cells_drawn == 0);
+    tm_canvas_unload(&c);
+}
+
+// Cell 0 shows the animated tile, cells 1..3 its frames drawn plainly (not animated themselves)
+static void anim_frame(tm_canvas *c, float frame_time) {
+    tm_input in = { 0 };
+    in.frame_time = frame_time;
+    in.mouse = (Vector2){ -1, -1 };
+    tm_input_inject(&in);
+    tm_canvas_begin(c);
+    tm_draw_glyph(RECT(0, 0, 1, 1), (atlaspos){ 0, 4 }, WHITE, BLACK);
+    for (int i = 0; i < 3; i++) tm_draw_glyph(RECT(1 + i, 0, 1, 1), (atlaspos){ 1 + i, 4 }, WHITE, BLACK);
+    tm_draw_text("static", CELL(0, 2), GREEN, BLACK);
+    tm_canvas_end(c);
+}
+
+static void test_anim_tiles(void) { // animated tiles follow the frame_time clock and keep frames coming
+    const atlaspos frames[3] = { { 1, 4 }, { 2, 4 }, { 3, 4 } };
+    CHECK(tm_animate_tile((tm_atlas){ 0 }, (atlaspos){ 0, 4 }, frames, 3, 0.25f));
+    tm_anim_set_clock(0);
+    tm_canvas c = tm_canvas_init(10, 4, false);
+    anim_frame(&c, 0);
+    int shown[6];
+    for (int f = 0; f < 6; f++) { // 0.125 s a frame, a new tile at 0.25, 0.5 and 0.75 (back to the first)
+        anim_frame(&c, 0.125f);
+        CHECK(tm_frame_needed());
+        const tm_cell *cells = tm_canvas_cells(&c);
+        int want = (int)(tm_anim_clock() / 0.25) % 3;
+        CHECK(cells[0].page == cells[1 + want].page && cells[0].glyph == cells[1 + want].glyph);
+        shown[f] = cells[0].glyph;
+        CHECK(tm_get_stats()->cells_drawn == f % 2); // the layout is the same, only the tile moves
+    }
+    CHECK(shown[0] != shown[1] && shown[1] != shown[3] && shown[3] != shown[0] && shown[5] == shown[0]);
+
+    // Nothing animated left on screen: an unchanged frame no longer asks for another
+    tm_clear_animations();
+    anim_frame(&c, 0.125f);
+    anim_frame(&c, 0.125f);
+    CHECK(!tm_frame_needed());
+    tm_canvas_unload(&c);
+}
+
+static long long term_captured = 0;
+
+static void term_capture(const char *bytes, int len, void *user) {
+    (void)bytes;
+    (void)user;
+    term_captured += len;
+}
+
+static void term_frame(tm_canvas *c, const char *text) {
+    begin_frame(c, -1, -1);
+    tm_draw_text(text, CELL(1, 1), WHITE, BLACK);
+    tm_draw_fill_rect(RECT(0, 3, 16, 1), BLUE);
+    tm_canvas_end(c);
+}
+
+static void test_term_output(void) { // the terminal backend writes changed cells only, nothing for an unchanged frame
+    tm_term_set_writer(term_capture, NULL);
+    tm_set_backend(&TM_BACKEND_TERM);
+    tm_canvas c = tm_canvas_init(16, 5, false);
+    tm_term_bytes_written(true);
+    term_captured = 0;
+
+    term_frame(&c, "hello");
+    long long first = tm_term_bytes_written(true);
+    CHECK(first > 0 && term_captured == first);
+    term_captured = 0;
+    term_frame(&c, "hello");
+    CHECK(tm_term_bytes_written(true) == 0);
+    CHECK(term_captured == 0);
+    term_frame(&c, "hellO"); // one cell: a cursor move, maybe a color, the character
+    long long one = tm_term_bytes_written(true);
+    CHECK(one > 0 && one < 32 && term_captured == one);
+
+    tm_canvas_unload(&c);
+    tm_set_backend(&TM_BACKEND_NULL);
+    tm_term_set_writer(NULL, NULL);
+}
+
+static void test_list_click(void) { // a click selects the row under it, empty list space selects nothing
+    tm_canvas c = tm_canvas_init(20, 10, false);
+    tm_list_state st = { 0, -1 };
+    list_click(&c, &st, 3, 1, RECT(0, 0, 10, 6), 2.5f, 1.5f); // first frame builds the owner map
+    list_click(&c, &st, 3, 1, RECT(0, 0, 10, 6), 2.5f, 1.5f);
+    CHECK(st.selected == 1);
+    list_click(&c, &st, 3, 1, RECT(0, 0, 10, 6), 2.5f, 5.5f); // below the last item
+    CHECK(st.selected == 1);
+
+    // Two rows of 2 cells fit in 5, the fifth cell is spare
+    tm_list_state tall = { 0, -1 };
+    list_click(&c, &tall, 10, 2, RECT(0, 0, 10, 5), 2.5f, 3.5f);
+    list_click(&c, &tall, 10, 2, RECT(0, 0, 10, 5), 2.5f, 3.5f);
+    CHECK(tall.selected == 1 && tall.first == 0);
+    list_click(&c, &tall, 10, 2, RECT(0, 0, 10, 5), 2.5f, 4.5f);
+    CHECK(tall.selected == 1 && tall.first == 0);
+    tm_canvas_unload(&c);
+}
+
+static void owner_map_frame(tm_canvas *c, float mouse_x, float mouse_y, int a_layer, tm_id ids[2]) {
+    begin_frame(c, mouse_x, mouse_y);
+    tm_set_layer(a_layer);
+    tm_button("A", RECT(0, 0, 10, 5));
+    ids[0] = tm_last_id();
+    tm_set_layer(0);
+    tm_button("B", RECT(5, 2, 10, 5));
+    ids[1] = tm_last_id();
+    tm_text("TEXT", RECT(6, 3, 4, 1)); // plain text over both claims nothing
+    tm_canvas_end(c);
+}
+
+static void test_owner_map(void) { // topmost widget per cell: later wins, a higher layer wins, hover follows
+    tm_canvas c = tm_canvas_init(20, 10, false);
+    tm_id ids[2];
+    owner_map_frame(&c, -1, -1, 0, ids);
+    tm_id a = ids[0], b = ids[1];
+    CHECK(a != 0 && b != 0 && a != b);
+    CHECK(tm_owner_at(&c, 1, 1) == a);
+    CHECK(tm_owner_at(&c, 7, 3) == b); // overlap, B was laid out later
+    CHECK(tm_owner_at(&c, 12, 6) == b);
+    CHECK(tm_owner_at(&c, 18, 9) == 0);
+    CHECK(tm_owner_at(&c, -1, 0) == 0 && tm_owner_at(&c, 20, 0) == 0 && tm_owner_at(&c, 0, 10) == 0);
+
+    owner_map_frame(&c, -1, -1, 1, ids);
+    CHECK(ids[0] == a && ids[1] == b);
+    CHECK(tm_owner_at(&c, 7, 3) == a); // A on a higher layer keeps the overlap
+    CHECK(tm_owner_at(&c, 12, 6) == b);
+
+    // Hover is resolved against the previous frame's map, one lookup at the mouse cell
+    owner_map_frame(&c, 7.5f, 3.5f, 1, ids);
+    CHECK(tm_hover_id() == a);
+    CHECK(tm_hovered(a) && !tm_hovered(b));
+    owner_map_frame(&c, 12.5f, 6.5f, 1, ids);
+    CHECK(tm_hover_id() == b);
+    CHECK(tm_hovered(b) && !tm_hovered(a));
+    owner_map_frame(&c, 18.5f, 9.5f, 1, ids);
+    CHECK(tm_hover_id() == 0 && !tm_hovered(a) && !tm_hovered(b));
+    tm_canvas_unload(&c);
+}
+
+static void test_palette(void) { // TM_PAL resolution, alpha 0 literals, literal colors with the palette in use
+    tm_set_palette(5, RED);
+    CHECK(color_is(tm_get_palette(5), RED));
+    CHECK(tm_get_palette(0).a == 0);
+    CHECK(color_is(tm_get_palette(300), BLANK));
+    tm_set_palette(0, RED); // entry 0 stays transparent
+    CHECK(tm_get_palette(0).a == 0);
+
+    tm_canvas c = tm_canvas_init(40, 4, false), ref = tm_canvas_init(40, 4, false);
+    begin_frame(&c, -1, -1);
+    tm_draw_fill_rect(RECT(0, 0, 1, 1), TM_PAL(5));
+    tm_canvas_end(&c);
+    CHECK(color_is(tm_canvas_cells(&c)[0].bg, RED));
+
+    // Changing the entry re-renders cells drawn with it, also when the layout is the same
+    tm_set_palette(5, GREEN);
+    begin_frame(&c, -1, -1);
+    tm_draw_fill_rect(RECT(0, 0, 1, 1), TM_PAL(5));
+    tm_canvas_end(&c);
+    CHECK(color_is(tm_canvas_cells(&c)[0].bg, GREEN));
+
+    // A literal with alpha 0 is not a palette reference, whatever its r: it draws like BLANK
+    begin_frame(&c, -1, -1);
+    tm_draw_fill_rect(RECT(0, 0, 1, 1), (Color){ 5, 0, 0, 0 });
+    tm_draw_fill_rect(RECT(1, 0, 1, 1), (Color){ 5, 255, 255, 0 });
+    tm_canvas_end(&c);
+    begin_frame(&ref, -1, -1);
+    tm_draw_fill_rect(RECT(0, 0, 2, 1), BLANK);
+    tm_canvas_end(&ref);
+    CHECK(same_cells(&c, &ref));
+
+    // New literal colors every frame, more than the palette holds over the run: each frame shows them exactly
+    // and entries set with tm_set_palette keep their color
+    Color user[16];
+    for (int i = 0; i < 16; i++) user[i] = (Color){ (unsigned char)(i * 16), 200, 100, 255 };
+    tm_set_palette_range(1, 16, user);
+    int wrong = 0;
+    for (int f = 0; f < 60; f++) {
+        begin_frame(&c, -1, -1);
+        for (int x = 0; x < 30; x++) tm_draw_fill_rect(RECT(x, 1, 1, 1), (Color){ (unsigned char)(f * 4 + x), (unsigned char)x, 7, 255 });
+        tm_draw_fill_rect(RECT(0, 2, 1, 1), TM_PAL(3));
+        tm_canvas_end(&c);
+        const tm_cell *cells = tm_canvas_cells(&c);
+        for (int x = 0; x < 30; x++)
+            if (!color_is(cells[40 + x].bg, (Color){ (unsigned char)(f * 4 + x), (unsigned char)x, 7, 255 })) wrong++;
+        if (!color_is(cells[80].bg, user[2])) wrong++;
+    }
+    CHECK(wrong == 0);
+    int overwritten = 0;
+    for (int i = 0; i < 16; i++) overwritten += !color_is(tm_get_palette(1 + i), user[i]);
+    CHECK(overwritten == 0);
+
+    tm_canvas_unload(&c);
+    tm_canvas_unload(&ref);
+}
+
+#define REC_FRAMES 12
+#define REC_W 24
+#define REC_H 8
+
+static Font rec_font;
+static tm_list_state rec_list;
+
+static void rec_row(int row, grect area, void *user) {
+    (void)user;
+    char text[16];
+    snprintf(text, sizeof(text), "ROW %d", row);
+    tm_text(text, area);
+}
+
+static void rec_ui(int frame) {
+    tm_button("PRESS", RECT(0, 0, 7, 3));
+    tm_list(&rec_list, 100, 1, rec_row, NULL, RECT(8, 0, 10, 5));
+    tm_set_font(&rec_font);
+    tm_text("FONT", RECT(0, 6, 4, 1));
+    tm_set_font(NULL);
+    tm_set_layer(1);
+    tm_label("TOP", RECT(frame % 10, 7, 3, 1));
+    tm_set_layer(0);
+}
+
+static bool same_input(const tm_input *a, const tm_input *b) { // at the recording's resolution
+    if (a->buttons != b->buttons || a->key_count != b->key_count || a->key_repeat != b->key_repeat) return false;
+    if ((int)(a->mouse.x * 16) != (int)(b->mouse.x * 16) || (int)(a->mouse.y * 16) != (int)(b->mouse.y * 16)) return false;
+    if ((int)(a->wheel * 16) != (int)(b->wheel * 16)) return false;
+    float dt = a->frame_time - b->frame_time; // whole microseconds in the file
+    if (dt > 1e-6f || dt < -1e-6f) return false;
+    for (int k = 0; k < a->key_count; k++)
+        if (a->keys[k] != b->keys[k]) return false;
+    return true;
+}
+
+// Cell content from absolute coordinates, so a canvas can be drawn whole or as column slices of it
+static void raster_content(tm_canvas *c, int x0) {
+    static const Color colors[] = { { 200, 40, 40, 255 }, { 40, 200, 90, 255 }, { 50, 80, 220, 255 },
+                                    { 230, 210, 60, 255 }, { 20, 20, 30, 255 }, { 120, 120, 120, 255 } };
+    begin_frame(c, -1, -1);
+    for (int y = 0; y < c->grid_h; y++) {
+        for (int x = 0; x < c->grid_w; x++) {
+            int ax = x0 + x;
+            tm_draw_glyph(RECT(x, y, 1, 1), (atlaspos){ (ax + y) % 16, (ax * y) % 8 }, colors[(ax + 2 * y) % 6],
+                          colors[(ax / 3 + y) % 6]);
+        }
+        char text[16];
+        snprintf(text, sizeof(text), "R%02d", y);
+        if (x0 == 0) tm_draw_text(text, CELL(1, y), WHITE, BLACK); // font page too
+    }
+    tm_set_layer(1); // blended over the base
+    for (int y = 0; y < c->grid_h; y += 3)
+        for (int x = 0; x < c->grid_w; x++)
+            if ((x0 + x + y) % 5 == 0) tm_draw_fill_rect(RECT(x, y, 1, 1), (Color){ 255, 0, 0, 96 });
+    tm_set_layer(0);
+    tm_canvas_end(c);
+}
+
+static void test_raster_bands(void) { // banded tm_soft_render on the pool = inline render, byte for byte
+    enum { W = 128, H = 40, HALF = W / 2 }; // 5120 cells go to the pool, the 2560 cell halves are rendered inline
+    tm_canvas whole = tm_canvas_init(W, H, false);
+    tm_canvas half[2] = { tm_canvas_init(HALF, H, false), tm_canvas_init(HALF, H, false) };
+    CHECK(tm_canvas_add_layer(&whole, "top", true) == 1);
+    for (int i = 0; i < 2; i++) CHECK(tm_canvas_add_layer(&half[i], "top", true) == 1);
+    raster_content(&whole, 0);
+    for (int i = 0; i < 2; i++) raster_content(&half[i], i * HALF);
+
+    unsigned char *image = malloc(tm_soft_buffer_size(&whole));
+    unsigned char *parts[2] = { malloc(tm_soft_buffer_size(&half[0])), malloc(tm_soft_buffer_size(&half[1])) };
+    int wrong_rows = 0;
+    for (int run = 0; run < 3; run++) { // the pool assigns bands differently from run to run
+        tm_soft_render(&whole, image);
+        for (int i = 0; i < 2; i++) tm_soft_render(&half[i], parts[i]);
+        int stride = W * 8 * 4, half_stride = stride / 2; // 8 pixel cells, RGBA
+        for (int py = 0; py < H * 8; py++)
+            for (int i = 0; i < 2; i++)
+                if (memcmp(image + py * stride + i * half_stride, parts[i] + py * half_stride, half_stride) != 0) wrong_rows++;
+    }
+    CHECK(wrong_rows == 0);
+
+    free(image);
+    free(parts[0]);
+    free(parts[1]);
+    tm_canvas_unload(&whole);
+    for (int i = 0; i < 2; i++) tm_canvas_unload(&half[i]);
+}
+
+static void test_record_replay(void) { // TMRC: cells of every layer and the input track come back as recorded
+    static tm_cell live[REC_FRAMES][2][REC_W * REC_H];
+    tm_input script[REC_FRAMES];
+    memset(script, 0, sizeof(script));
+    for (int f = 0; f < REC_FRAMES; f++) {
+        script[f].frame_time = 1.0f / 60.0f;
+        script[f].mouse = (Vector2){ 2.3f + f * 0.7f, 1.5f + (f % 3) * 0.25f };
+    }
+    script[2].buttons = script[3].buttons = 1 << MOUSE_BUTTON_LEFT; // click the button
+    script[6].mouse = script[7].mouse = script[8].mouse = (Vector2){ 9.5f, 2.5f };
+    script[6].buttons = 1 << MOUSE_BUTTON_LEFT; // select a row, which gives the list the keys
+    script[7].wheel = -1.5f;
+    script[8].key_count = 2;
+    script[8].keys[0] = KEY_DOWN;
+    script[8].keys[1] = KEY_END;
+    script[9].key_count = 1;
+    script[9].keys[0] = KEY_DOWN;
+    script[9].key_repeat = 1;
+
+    const char *path = "tm_test.tmrc";
+    rec_font = tm_load_font("fonts/URSA.ttf");
+    rec_list = (tm_list_state){ 0, -1 };
+    tm_canvas c = tm_canvas_init(REC_W, REC_H, false);
+    CHECK(tm_canvas_add_layer(&c, "top", true) == 1);
+    CHECK(tm_record_start(&c, path));
+    tm_input_script(script, REC_FRAMES);
+    for (int f = 0; f < REC_FRAMES; f++) {
+        tm_canvas_begin(&c);
+        rec_ui(f);
+        tm_canvas_end(&c);
+        for (int l = 0; l < 2; l++) memcpy(live[f][l], tm_canvas_cells(tm_canvas_get_layer(&c, l)), sizeof(live[f][l]));
+    }
+    tm_record_stop();
+    tm_input_script(NULL, 0);
+    CHECK(rec_list.selected > 0);
+    tm_canvas_unload(&c);
+
+    // Cells and input back, frame by frame
+    tm_canvas r;
+    CHECK(tm_replay_open(path, &r));
+    CHECK(r.grid_w == REC_W && r.grid_h == REC_H && r.layer_count == 1);
+    int frames = 0, cells_wrong = 0, input_wrong = 0;
+    tm_input in;
+    for (bool more = true; more && frames < REC_FRAMES + 1;) {
+        more = tm_replay_frame(&r, &in);
+        if (!more) break;
+        for (int l = 0; l < 2; l++)
+            if (memcmp(tm_canvas_cells(tm_canvas_get_layer(&r, l)), live[frames][l], sizeof(live[frames][l])) != 0) cells_wrong++;
+        if (frames < REC_FRAMES && !same_input(&in, &script[frames])) input_wrong++;
+        frames++;
+    }
+    tm_replay_close();
+    tm_canvas_unload(&r);
+    CHECK(frames == REC_FRAMES);
+    CHECK(cells_wrong == 0);
+    CHECK(input_wrong == 0);
+
+    tm_input back[REC_FRAMES + 4];
+    CHECK(tm_replay_inputs(path, back, REC_FRAMES + 4) == REC_FRAMES);
+    input_wrong = 0;
+    for (int f = 0; f < REC_FRAMES; f++) input_wrong += !same_input(&back[f], &script[f]);
+    CHECK(input_wrong == 0);
+
+    // Another font loaded first moves the recorded one to the next slot: the cells follow it there
+    tmgui_shutdown();
+    tmgui_init(8, 8);
+    tm_set_backend(&TM_BACKEND_NULL);
+    tm_load_font("fonts/DUNGEONMODE.ttf");
+    CHECK(tm_replay_open(path, &r));
+    while (tm_replay_frame(&r, NULL)) {}
+    tm_replay_close();
+    const tm_cell *cells = tm_canvas_cells(&r), *was = live[REC_FRAMES - 1][0];
+    int font_cell = 6 * REC_W, moved = 0, others_wrong = 0;
+    for (int i = 0; i < REC_W * REC_H; i++) {
+        if (was[i].page == was[font_cell].page) moved += cells[i].page == was[i].page + 1 && cells[i].glyph == was[i].glyph;
+        else others_wrong += cells[i].page != was[i].page || cells[i].glyph != was[i].glyph;
+    }
+    CHECK(was[font_cell].page > TM_PAGE_FONT);
+    CHECK(moved > 0 && others_wrong == 0);
+    tm_canvas_unload(&r);
+    remove(path);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} test;
+
+static const test tests[] = {
+    { "input_script", test_input_script },
+    { "log_ring", test_log_ring },
+    { "id_stack", test_id_stack },
+    { "box_nesting", test_box_nesting },
+    { "owner_map", test_owner_map },
+    { "frame_skip", test_frame_skip },
+    { "anim_tiles", test_anim_tiles },
+    { "term_output", test_term_output },
+    { "list_click", test_list_click },
+    { "palette", test_palette },
+    { "raster_bands", test_raster_bands },
+    { "record_replay", test_record_replay },
+};
+
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else { fprintf(stderr, "usage: %s [--filter name]\n", argv[0]); return 1; }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    tmgui_init(8, 8); // cells only: missing asset files leave glyphs blank on both sides of a comparison
+    tm_set_backend(&TM_BACKEND_NULL);
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        if (filter && !strstr(tests[i].name, filter)) continue;
+        int before = failures;
+        tests[i].run();
+        printf("%s %s\n", (failures == before) ? "ok  " : "FAIL", tests[i].name);
+    }
+    tmgui_shutdown();
+
+    printf("%d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+// TMGUI asset baker. Bakes fonts and glyph sheets into the grid pages tmgui would build at startup and
+// writes them out as C arrays, so a -DTMGUI_EMBED_ASSETS build starts with no file I/O or TTF rasterizing.
+//
+// Build from the repo root (raylib on the include/lib path):
+//   cc -O2 -Iinclude tools/tm_bake.c -lraylib -lm -o tm_bake
+//
+// Usage: tm_bake <cell_w> <cell_h> fonts/*.ttf glyphs/*.png > lib/tm_assets.h
+// Then build tmgui with -DTMGUI_EMBED_ASSETS. Assets are matched by "dir/file" name and cell size, anything
+// not embedded (or baked at another cell size) is still loaded from TM_ASSET_DIR on first use.
+
+#define TMGUI_NO_DEMO
+#include "../lib/tmgui.c" // reuses bake_font, so embedded pages are identical to runtime baked ones
+
+static const char *asset_name(const char *path) { // "dir/file", what embedded_asset matches against
+    const char *name = path, *prev = path;
+    for (const char *p = path; *p; p++) {
+        if (*p == '/' || *p == '\\') { prev = name; name = p + 1; }
+    }
+    return prev;
+}
+
+static void emit_bytes(const char *type, const char *id, const void *data, int n) {
+    const unsigned char *b = data;
+    printf("static const %s %s[] = {", type, id);
+    for (int i = 0; i < n; i++) printf("%s%u,", (i % 32) ? "" : "\n    ", b[i]);
+    printf("\n};\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <cell_w> <cell_h> <font.ttf | sheet.png>... > tm_assets.h\n", argv[0]);
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+    tmgui_init(atoi(argv[1]), atoi(argv[2]));
+
+    int count = argc - 3;
+    printf("// Generated by tools/tm_bake.c at %dx%d cells, do not edit.\n", cell_w, cell_h);
+    printf("// Regenerate: tm_bake %d %d", cell_w, cell_h);
+    for (int i = 3; i < argc; i++) printf(" %s", asset_name(argv[i]));
+    printf("\n\n");
+
+    for (int i = 0; i < count; i++) {
+        const char *path = argv[3 + i];
+        glyph_page page = { 0 };
+        font_slot slot = { 0 };
+        int channels = 4;
+
+        if (IsFileExtension(path, ".ttf;.otf")) {
+            Font font = load_font_data(path);
+            if (font.glyphs == NULL) { fprintf(stderr, "tm_bake: could not load %s\n", path); return 1; }
+            bake_font(&page, &slot, font);
+            UnloadFontData(font.glyphs, font.glyphCount);
+
+            // Font pages are white glyphs, only the alpha is stored
+            int n = page.image.width * page.image.height;
+            unsigned char *alpha = malloc(n);
+            for (int p = 0; p < n; p++) alpha[p] = ((Color *)page.image.data)[p].a;
+            char id[32];
+            snprintf(id, sizeof(id), "tm_asset_%d_lut", i);
+            printf("static const unsigned short %s[256] = {", id);
+            for (int c = 0; c < 256; c++) printf("%s%u,", (c % 16) ? "" : "\n    ", slot.lut[c]);
+            printf("\n};\n");
+            snprintf(id, sizeof(id), "tm_asset_%d_pixels", i);
+            emit_bytes("unsigned char", id, alpha, n);
+            free(alpha);
+            channels = 1;
+        } else {
+            page.image = LoadImage(path);
+            if (page.image.data == NULL) { fprintf(stderr, "tm_bake: could not load %s\n", path); return 1; }
+            ImageFormat(&page.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+            page.cols = page.image.width / cell_w;
+            if (page.cols < 1) page.cols = 1;
+            page.count = page.cols * (page.image.height / cell_h);
+            char id[32];
+            snprintf(id, sizeof(id), "tm_asset_%d_pixels", i);
+            emit_bytes("unsigned char", id, page.image.data, page.image.width * page.image.height * 4);
+        }
+
+        char lut[32] = "NULL";
+        if (channels == 1) snprintf(lut, sizeof(lut), "tm_asset_%d_lut", i);
+        printf("#define TM_ASSET_%d { \"%s\", %d, %d, %d, %d, %s, tm_asset_%d_pixels, %d, %d, %d }\n\n", i,
+               asset_name(path), cell_w, cell_h, page.cols, page.count, lut, i,
+               page.image.width, page.image.height, channels);
+        UnloadImage(page.image);
+    }
+
+    printf("static const tm_embedded_asset TM_EMBEDDED_ASSETS[] = {\n");
+    for (int i = 0; i < count; i++) printf("    TM_ASSET_%d,\n", i);
+    printf("};\n#define TM_EMBEDDED_ASSET_COUNT %d\n", count);
+
+    tmgui_shutdown();
+    return 0;
+}